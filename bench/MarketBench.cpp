@@ -0,0 +1,275 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "misc/BenchUtilities.h"
+
+#include "clob/Clock.h"
+#include "clob/LimitOrder.h"
+#include "clob/Market.h"
+
+using namespace clob;
+
+namespace {
+
+constexpr std::size_t kRepetitions{5};
+constexpr std::size_t kRestingOrders{100000};
+constexpr price_t kBasePrice{10000};
+constexpr price_t kNumLevels{64};
+constexpr quantity_t kQuantity{100};
+
+/**
+ * @brief Make the i-th of a set of distinct tickers.
+ */
+std::string make_ticker(std::size_t i) {
+  std::string ticker;
+  do {
+    ticker.push_back(static_cast<char>('A' + i % 26));
+    i /= 26;
+  } while (i != 0);
+  return ticker;
+}
+
+/**
+ * @brief Build a market with one stock and kRestingOrders resting bids.
+ */
+std::unique_ptr<Market> make_market(const std::size_t order_capacity = 0) {
+  auto market = std::make_unique<Market>("bench", "BNCH");
+  market->set_order_capacity(order_capacity);
+  market->add_stock("stock", "STCK");
+  for (std::size_t i = 0; i < kRestingOrders; ++i) {
+    market->add_order<LimitOrder::OrderType::Bid>(
+        0, kBasePrice + static_cast<price_t>(i % kNumLevels), kQuantity);
+  }
+  return market;
+}
+
+/**
+ * @brief Time amending every resting order through a callable.
+ */
+template <typename Amend>
+void run(const char *name, Amend amend, const std::size_t order_capacity = 0) {
+  std::unique_ptr<Market> market;
+  const double ns = bench::best_of_ns(
+      kRepetitions, [&] { market = make_market(order_capacity); },
+      [&] {
+        for (LimitOrder::id_t id = 0; id < kRestingOrders; ++id) {
+          amend(*market, id);
+        }
+      });
+  bench::do_not_optimize(market->get_order_book(0)->bids_size());
+  bench::report(name, kRestingOrders, ns);
+}
+
+/**
+ * @brief Time adding kRestingOrders orders to an empty market whose clock is
+ * in a given mode.
+ */
+void run_add(const char *name, const ClockMode mode) {
+  std::unique_ptr<Market> market;
+  if (!Clock{}.configure(mode)) {
+    std::printf("%-50s unsupported\n", name);
+    return;
+  }
+  const double ns = bench::best_of_ns(
+      kRepetitions,
+      [&] {
+        market = std::make_unique<Market>("bench", "BNCH");
+        market->set_clock(mode);
+        market->add_stock("stock", "STCK");
+      },
+      [&] {
+        for (std::size_t i = 0; i < kRestingOrders; ++i) {
+          market->add_order<LimitOrder::OrderType::Bid>(
+              0, kBasePrice + static_cast<price_t>(i % kNumLevels), kQuantity);
+        }
+      });
+  bench::do_not_optimize(market->get_order_book(0)->bids_size());
+  bench::report(name, kRestingOrders, ns);
+}
+
+/**
+ * @brief Time reading a clock in each mode.
+ */
+void run_clock() {
+  constexpr std::size_t kReads{1000000};
+  for (const auto &[name, mode] :
+       {std::pair{"clock/system", ClockMode::System},
+        std::pair{"clock/tsc", ClockMode::Tsc},
+        std::pair{"clock/manual", ClockMode::Manual}}) {
+    Clock clock;
+    if (!clock.configure(mode)) {
+      std::printf("%-50s unsupported\n", name);
+      continue;
+    }
+    const double ns = bench::best_of_ns(kRepetitions, [] {}, [&] {
+      timestamp_ns_t sum{0};
+      for (std::size_t i = 0; i < kReads; ++i) {
+        sum += clock.now();
+      }
+      bench::do_not_optimize(sum);
+    });
+    bench::report(name, kReads, ns);
+  }
+}
+
+/**
+ * @brief Time cancelling every resting order of a stock and summing its traded
+ * volume, both driven by scans of the order store.
+ */
+void run_scans() {
+  std::unique_ptr<Market> market;
+  const double cancel_ns = bench::best_of_ns(
+      kRepetitions, [&] { market = make_market(); },
+      [&] { bench::do_not_optimize(market->cancel_all_orders(0)); });
+  bench::report("scan/cancel_all", kRestingOrders, cancel_ns);
+
+  market = make_market();
+  const double volume_ns = bench::best_of_ns(
+      kRepetitions, [] {},
+      [&] { bench::do_not_optimize(market->get_traded_volume(0)); });
+  bench::report("scan/traded_volume", kRestingOrders, volume_ns);
+}
+
+/**
+ * @brief Time every add_stock and add_order individually on a cold and on a
+ * reserved market, reporting the median, p99.99 and worst latency.
+ */
+void run_tail_latency(const char *name, const bool reserved) {
+  constexpr std::size_t kStocks{4096};
+  constexpr std::size_t kOrders{1000000};
+  std::vector<double> latencies;
+  latencies.reserve(kStocks + kOrders);
+  std::vector<std::string> tickers;
+  for (std::size_t i = 0; i < kStocks; ++i) {
+    tickers.push_back(make_ticker(i));
+  }
+  Market market{"bench", "BNCH"};
+  if (reserved) {
+    market.reserve(kStocks, kOrders);
+  }
+  for (std::size_t i = 0; i < kStocks; ++i) {
+    latencies.push_back(
+        bench::time_ns([&] { market.add_stock("stock", tickers[i]); }));
+  }
+  for (std::size_t i = 0; i < kOrders; ++i) {
+    const auto stock_id = static_cast<Stock::id_t>(i % kStocks);
+    latencies.push_back(bench::time_ns([&] {
+      market.add_order<LimitOrder::OrderType::Bid>(
+          stock_id, kBasePrice + static_cast<price_t>(i % kNumLevels),
+          kQuantity);
+    }));
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](const double p) {
+    return latencies[static_cast<std::size_t>(
+        p * static_cast<double>(latencies.size() - 1))];
+  };
+  std::printf("%-48s p50 %8.0f ns  p99.99 %8.0f ns  max %10.0f ns\n", name,
+              percentile(0.5), percentile(0.9999), latencies.back());
+}
+
+/**
+ * @brief Time resolving tickers to stocks in random order: through a string
+ * keyed hash map, as gateways did, and through the market's ticker index
+ * before and after freezing it.
+ */
+void run_ticker_lookup() {
+  constexpr std::size_t kStocks{100000};
+  constexpr std::size_t kLookups{1000000};
+  std::vector<std::string> tickers;
+  std::unordered_map<std::string, Stock::id_t> gateway;
+  Market market{"bench", "BNCH"};
+  market.reserve(kStocks, 0);
+  for (std::size_t i = 0; i < kStocks; ++i) {
+    tickers.push_back(make_ticker(i));
+    gateway.emplace(tickers.back(), i);
+    market.add_stock("stock", tickers.back());
+  }
+  std::vector<std::size_t> queries(kLookups);
+  std::mt19937 rng{42};
+  for (auto &query : queries) {
+    query = rng() % kStocks;
+  }
+  std::vector<TickerIndex::key_t> keys(kLookups);
+  for (std::size_t i = 0; i < kLookups; ++i) {
+    keys[i] = TickerIndex::pack(tickers[queries[i]]);
+  }
+
+  const double map_ns = bench::best_of_ns(kRepetitions, [] {}, [&] {
+    Stock::id_t sum{0};
+    for (const std::size_t query : queries) {
+      sum += gateway.find(tickers[query])->second;
+    }
+    bench::do_not_optimize(sum);
+  });
+  bench::report("ticker/string_map", kLookups, map_ns);
+
+  auto lookup = [&] {
+    Stock::id_t sum{0};
+    for (const TickerIndex::key_t key : keys) {
+      sum += market.find_stock(key)->id;
+    }
+    bench::do_not_optimize(sum);
+  };
+  bench::report("ticker/index", kLookups,
+                bench::best_of_ns(kRepetitions, [] {}, lookup));
+  market.freeze_stocks();
+  bench::report("ticker/index/frozen", kLookups,
+                bench::best_of_ns(kRepetitions, [] {}, lookup));
+}
+
+price_t lower_price(const LimitOrder::id_t id) {
+  return kBasePrice - 1 - static_cast<price_t>(id % kNumLevels);
+}
+
+} // namespace
+
+int main() {
+  run_add("add", ClockMode::System);
+  run_add("add/clock/tsc", ClockMode::Tsc);
+  run_add("add/clock/manual", ClockMode::Manual);
+  run_clock();
+  run_scans();
+  run_tail_latency("latency/add/cold", false);
+  run_tail_latency("latency/add/reserved", true);
+  run_ticker_lookup();
+  run("cancel_add/reduce_quantity", [](Market &market, LimitOrder::id_t id) {
+    const LimitOrder *order = market.query_order(id);
+    const price_t price = order->price;
+    market.cancel_order(id);
+    market.add_order<LimitOrder::OrderType::Bid>(0, price, kQuantity / 2);
+  });
+  run("modify/reduce_quantity", [](Market &market, LimitOrder::id_t id) {
+    market.modify_order(id, market.query_order(id)->price, kQuantity / 2);
+  });
+  run("cancel_add/change_price", [](Market &market, LimitOrder::id_t id) {
+    market.cancel_order(id);
+    market.add_order<LimitOrder::OrderType::Bid>(0, lower_price(id),
+                                                 kQuantity);
+  });
+  run("modify/change_price", [](Market &market, LimitOrder::id_t id) {
+    market.modify_order(id, lower_price(id), kQuantity);
+  });
+  run(
+      "cancel_add/change_price/recycled",
+      [](Market &market, LimitOrder::id_t id) {
+        market.cancel_order(id);
+        market.add_order<LimitOrder::OrderType::Bid>(0, lower_price(id),
+                                                     kQuantity);
+      },
+      kRestingOrders);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "misc/BenchUtilities.h"
+
+#include "clob/LimitOrder.h"
+#include "clob/OrderBook.h"
+
+using namespace clob;
+
+namespace {
+
+constexpr std::size_t kRepetitions{5};
+constexpr std::size_t kMatches{64};
+constexpr price_t kPrice{10000};
+constexpr quantity_t kQuantity{1000};
+
+/**
+ * @brief Time aggressive orders against a single level of num_orders resting
+ * asks, each taking a hundredth of the level so the level is never emptied.
+ */
+template <typename Book>
+void run(const char *name, const std::size_t num_orders) {
+  std::vector<LimitOrder> asks;
+  std::vector<LimitOrder> bids;
+  std::unique_ptr<Book> book;
+  char label[64];
+
+  const double ns = bench::best_of_ns(
+      kRepetitions,
+      [&] {
+        book = std::make_unique<Book>();
+        asks.clear();
+        asks.reserve(num_orders);
+        for (std::size_t i = 0; i < num_orders; ++i) {
+          asks.emplace_back(i, i, kPrice, kQuantity);
+          book->add_ask_order(&asks.back());
+        }
+        bids.clear();
+        bids.reserve(kMatches);
+        for (std::size_t i = 0; i < kMatches; ++i) {
+          bids.emplace_back(num_orders + i, num_orders + i, kPrice,
+                            static_cast<quantity_t>(num_orders * 10));
+        }
+      },
+      [&] {
+        for (auto &order : bids) {
+          book->add_bid_order(&order);
+        }
+      });
+  bench::do_not_optimize(book->asks_size());
+  std::snprintf(label, sizeof(label), "%s/match/orders:%u", name,
+                static_cast<unsigned>(num_orders));
+  bench::report(label, kMatches, ns);
+}
+
+enum class Sweep { Limit, Market, MarketBand };
+
+/**
+ * @brief Time one aggressive bid sweeping num_levels levels of one ask each,
+ * sent as a limit order at the highest price, as a market order, or as a
+ * market order whose band covers every level.
+ */
+void run_sweep(const char *name, const std::size_t num_levels,
+               const Sweep sweep) {
+  std::vector<LimitOrder> asks;
+  std::unique_ptr<MapOrderBook> book;
+  LimitOrder bid{num_levels, num_levels, 0, 0};
+  char label[64];
+
+  const double ns = bench::best_of_ns(
+      kRepetitions,
+      [&] {
+        book = std::make_unique<MapOrderBook>();
+        asks.clear();
+        asks.reserve(num_levels);
+        for (std::size_t i = 0; i < num_levels; ++i) {
+          asks.emplace_back(i, i, kPrice + static_cast<price_t>(i), 1);
+          book->add_ask_order(&asks.back());
+        }
+        bid = LimitOrder{num_levels, num_levels,
+                         kPrice + static_cast<price_t>(num_levels),
+                         static_cast<quantity_t>(num_levels)};
+      },
+      [&] {
+        if (sweep == Sweep::Limit) {
+          book->add_bid_order(&bid);
+        } else if (sweep == Sweep::Market) {
+          book->add_market_bid_order(&bid);
+        } else {
+          book->add_market_bid_order(&bid,
+                                     static_cast<price_t>(num_levels));
+        }
+      });
+  bench::do_not_optimize(bid.filled_quantity);
+  std::snprintf(label, sizeof(label), "%s/sweep/levels:%u", name,
+                static_cast<unsigned>(num_levels));
+  bench::report(label, num_levels, ns);
+}
+
+} // namespace
+
+int main() {
+  for (const std::size_t num_orders : {std::size_t{1000}, std::size_t{4000}}) {
+    run<MapOrderBook>("fifo", num_orders);
+    run<ProRataOrderBook>("pro-rata", num_orders);
+    run<FifoProRataOrderBook>("fifo-pro-rata", num_orders);
+  }
+  for (const std::size_t num_levels : {std::size_t{64}, std::size_t{1024}}) {
+    run_sweep("limit", num_levels, Sweep::Limit);
+    run_sweep("market", num_levels, Sweep::Market);
+    run_sweep("market-band", num_levels, Sweep::MarketBand);
+  }
+  return 0;
+}
\ No newline at end of file
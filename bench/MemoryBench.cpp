@@ -0,0 +1,172 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "misc/BenchUtilities.h"
+
+#include "clob/HugePageArena.h"
+#include "clob/LimitOrder.h"
+#include "clob/OrderBook.h"
+#include "clob/OrderStore.h"
+
+using namespace clob;
+
+namespace {
+
+constexpr std::size_t kRepetitions{3};
+constexpr std::size_t kOrders{std::size_t{1} << 22};
+constexpr price_t kBasePrice{10000};
+constexpr price_t kNumLevels{1 << 16};
+constexpr quantity_t kQuantity{10};
+
+/**
+ * @brief Counts data TLB read misses of the calling thread, where the kernel
+ * lets us.
+ */
+class DtlbCounter {
+  int fd{-1};
+
+public:
+  DtlbCounter() {
+#ifdef __linux__
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  ~DtlbCounter() {
+#ifdef __linux__
+    if (fd >= 0) {
+      close(fd);
+    }
+#endif
+  }
+
+  bool available() const { return fd >= 0; }
+
+  void start() {
+#ifdef __linux__
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  std::uint64_t stop() {
+    std::uint64_t count{0};
+#ifdef __linux__
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+      }
+    }
+#endif
+    return count;
+  }
+};
+
+/**
+ * @brief Time filling every resting order of a book spread over many levels,
+ * with orders and levels drawn from an arena in the given mode, and count the
+ * data TLB misses of the timed runs.
+ */
+void run(const char *name, const HugePageMode mode) {
+  std::vector<std::size_t> queue(kOrders);
+  std::iota(queue.begin(), queue.end(), std::size_t{0});
+  std::shuffle(queue.begin(), queue.end(), std::mt19937{42});
+  std::vector<LimitOrder> bids;
+  bids.reserve(kOrders);
+  for (std::size_t i = 0; i < kOrders; ++i) {
+    bids.emplace_back(kOrders + i, kOrders + i, kBasePrice, kQuantity);
+  }
+
+  std::unique_ptr<HugePageArena> arena;
+  std::unique_ptr<OrderStore> store;
+  std::unique_ptr<HugePageOrderBook> book;
+  DtlbCounter counter;
+  std::uint64_t misses{0};
+  HugePageStats stats{};
+  const double ns = bench::best_of_ns(
+      kRepetitions,
+      [&] {
+        book.reset();
+        store.reset();
+        arena = std::make_unique<HugePageArena>(HugePageConfig{mode});
+        store = std::make_unique<OrderStore>(arena.get());
+        book = std::make_unique<HugePageOrderBook>(
+            HugePageOrderBook::config_t{},
+            HugePageAllocator<PriceLevel>(arena.get()));
+        for (std::size_t i = 0; i < kOrders; ++i) {
+          store->create(0, LimitOrder::OrderType::Ask, 0, 0, 0, 0);
+        }
+        // Scatter the queue of every level over the whole store.
+        for (std::size_t i = 0; i < kOrders; ++i) {
+          LimitOrder *order =
+              store->get(static_cast<OrderStore::handle_t>(queue[i]));
+          *order = LimitOrder{
+              order->id, i,
+              kBasePrice + static_cast<price_t>(i % kNumLevels), kQuantity};
+          book->add_ask_order(order);
+        }
+        for (auto &bid : bids) {
+          bid = LimitOrder{bid.id, bid.sequence, kBasePrice + kNumLevels,
+                           kQuantity};
+        }
+        stats = arena->stats();
+        counter.start();
+      },
+      [&] {
+        for (auto &bid : bids) {
+          book->add_bid_order(&bid);
+        }
+        const std::uint64_t run_misses = counter.stop();
+        misses = misses == 0 || run_misses < misses ? run_misses : misses;
+      });
+  bench::do_not_optimize(book->asks_size());
+  bench::report(name, kOrders, ns);
+  if (counter.available()) {
+    std::printf("  dTLB read misses/op %.3f", static_cast<double>(misses) /
+                                                  static_cast<double>(kOrders));
+  } else {
+    std::printf("  dTLB read misses/op n/a");
+  }
+  std::printf(", pages: %zu huge, %zu transparent, %zu normal\n",
+              stats.huge_pages, stats.transparent_pages, stats.normal_pages);
+}
+
+} // namespace
+
+int main() {
+  run("fill/huge-pages:off", HugePageMode::Off);
+  run("fill/huge-pages:transparent", HugePageMode::Transparent);
+  run("fill/huge-pages:explicit", HugePageMode::Explicit);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,246 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "misc/BenchUtilities.h"
+
+#include "clob/LimitOrder.h"
+#include "clob/OrderBook.h"
+
+using namespace clob;
+
+namespace {
+
+/**
+ * @brief The previous order book, one binary heap of orders per side.
+ *
+ * @details Kept only as the reference point for the price level ladder.
+ */
+class OrderHeapBook {
+  std::priority_queue<LimitOrder *, std::vector<LimitOrder *>,
+                      LimitOrder::PriceTimeQueuePriority::BidCmp>
+      bids;
+  std::priority_queue<LimitOrder *, std::vector<LimitOrder *>,
+                      LimitOrder::PriceTimeQueuePriority::AskCmp>
+      asks;
+
+  template <typename Book, typename NewBook, bool is_bid>
+  static void match(Book &book, NewBook &new_book, LimitOrder *new_order) {
+    constexpr balance_t balance_sign{is_bid ? 1 : -1};
+    quantity_t order_q{}, new_order_q{new_order->quantity};
+    while (!book.empty() && new_order_q != 0) {
+      LimitOrder *order = book.top();
+      if (order->is_cancelled) {
+        book.pop();
+        continue;
+      }
+      if (is_bid ? order->price > new_order->price
+                 : order->price < new_order->price) {
+        break;
+      }
+      order_q = order->quantity - order->filled_quantity;
+      if (order_q <= new_order_q) {
+        new_order->balance -= balance_sign * order_q * order->price;
+        order->balance += balance_sign * order_q * order->price;
+        new_order->filled_quantity += order_q;
+        new_order_q -= order_q;
+        order->filled_quantity = order->quantity;
+        book.pop();
+      } else {
+        new_order->balance -= balance_sign * new_order_q * order->price;
+        order->balance += balance_sign * new_order_q * order->price;
+        order->filled_quantity += new_order_q;
+        new_order->filled_quantity = new_order->quantity;
+        return;
+      }
+    }
+    if (new_order_q != 0) {
+      new_book.push(new_order);
+    }
+  }
+
+public:
+  void add_bid_order(LimitOrder *order) {
+    match<decltype(asks), decltype(bids), true>(asks, bids, order);
+  }
+  void add_ask_order(LimitOrder *order) {
+    match<decltype(bids), decltype(asks), false>(bids, asks, order);
+  }
+  std::size_t asks_size() const { return asks.size(); }
+};
+
+constexpr std::size_t kRepetitions{5};
+constexpr std::size_t kRestingOrders{200000};
+constexpr price_t kBasePrice{10000};
+constexpr quantity_t kQuantity{10};
+
+/**
+ * @brief Build resting asks spread round-robin over num_levels prices.
+ */
+void make_resting_asks(std::vector<LimitOrder> &orders,
+                       const price_t num_levels) {
+  orders.clear();
+  orders.reserve(kRestingOrders);
+  for (std::size_t i = 0; i < kRestingOrders; ++i) {
+    orders.emplace_back(i, i, kBasePrice + static_cast<price_t>(i % num_levels),
+                        kQuantity);
+  }
+}
+
+/**
+ * @brief Build aggressive bids which each fill exactly one resting ask.
+ */
+void make_aggressive_bids(std::vector<LimitOrder> &orders,
+                          const price_t num_levels) {
+  orders.clear();
+  orders.reserve(kRestingOrders);
+  for (std::size_t i = 0; i < kRestingOrders; ++i) {
+    orders.emplace_back(kRestingOrders + i, kRestingOrders + i,
+                        kBasePrice + num_levels, kQuantity);
+  }
+}
+
+/**
+ * @brief Time resting order insertion, one-for-one fills and a single order
+ * sweeping the whole book.
+ */
+template <typename Book, typename MakeBook>
+void run(const char *name, const price_t num_levels, MakeBook make_book) {
+  std::vector<LimitOrder> asks;
+  std::vector<LimitOrder> bids;
+  std::unique_ptr<Book> book;
+  char label[64];
+
+  const double insert_ns = bench::best_of_ns(
+      kRepetitions,
+      [&] {
+        book = make_book();
+        make_resting_asks(asks, num_levels);
+      },
+      [&] {
+        for (auto &order : asks) {
+          book->add_ask_order(&order);
+        }
+      });
+  std::snprintf(label, sizeof(label), "%s/insert/levels:%u", name,
+                static_cast<unsigned>(num_levels));
+  bench::report(label, kRestingOrders, insert_ns);
+
+  const double fill_ns = bench::best_of_ns(
+      kRepetitions,
+      [&] {
+        book = make_book();
+        make_resting_asks(asks, num_levels);
+        for (auto &order : asks) {
+          book->add_ask_order(&order);
+        }
+        make_aggressive_bids(bids, num_levels);
+      },
+      [&] {
+        for (auto &order : bids) {
+          book->add_bid_order(&order);
+        }
+      });
+  bench::do_not_optimize(book->asks_size());
+  std::snprintf(label, sizeof(label), "%s/fill/levels:%u", name,
+                static_cast<unsigned>(num_levels));
+  bench::report(label, kRestingOrders, fill_ns);
+
+  LimitOrder sweep{2 * kRestingOrders, 2 * kRestingOrders, 0, 0};
+  const double sweep_ns = bench::best_of_ns(
+      kRepetitions,
+      [&] {
+        book = make_book();
+        make_resting_asks(asks, num_levels);
+        for (auto &order : asks) {
+          book->add_ask_order(&order);
+        }
+        sweep = LimitOrder{2 * kRestingOrders, 2 * kRestingOrders,
+                           kBasePrice + num_levels,
+                           static_cast<quantity_t>(kRestingOrders * kQuantity -
+                                                   kQuantity / 2)};
+      },
+      [&] { book->add_bid_order(&sweep); });
+  bench::do_not_optimize(book->asks_size());
+  std::snprintf(label, sizeof(label), "%s/sweep/levels:%u", name,
+                static_cast<unsigned>(num_levels));
+  bench::report(label, kRestingOrders, sweep_ns);
+}
+
+/**
+ * @brief Time sweeping one deep level whose FIFO order is scattered in
+ * memory, as it is when orders of many books are allocated interleaved, so
+ * every order costs a cache miss.
+ */
+void run_deep_sweep(const std::size_t num_orders) {
+  std::vector<LimitOrder> asks;
+  std::vector<std::size_t> queue(num_orders);
+  std::iota(queue.begin(), queue.end(), std::size_t{0});
+  std::shuffle(queue.begin(), queue.end(), std::mt19937{42});
+  std::unique_ptr<MapOrderBook> book;
+  LimitOrder sweep{num_orders, num_orders, 0, 0};
+  char label[64];
+
+  const double ns = bench::best_of_ns(
+      kRepetitions,
+      [&] {
+        book = std::make_unique<MapOrderBook>();
+        asks.clear();
+        asks.reserve(num_orders);
+        for (std::size_t i = 0; i < num_orders; ++i) {
+          asks.emplace_back(i, 0, kBasePrice, kQuantity);
+        }
+        for (std::size_t i = 0; i < num_orders; ++i) {
+          asks[queue[i]].sequence = i;
+          book->add_ask_order(&asks[queue[i]]);
+        }
+        sweep = LimitOrder{num_orders, num_orders, kBasePrice,
+                           static_cast<quantity_t>(num_orders * kQuantity -
+                                                   kQuantity / 2)};
+      },
+      [&] { book->add_bid_order(&sweep); });
+  bench::do_not_optimize(book->asks_size());
+  std::snprintf(label, sizeof(label), "deep-sweep/orders:%u/bytes:%u",
+                static_cast<unsigned>(num_orders),
+                static_cast<unsigned>(sizeof(LimitOrder)));
+  bench::report(label, num_orders, ns);
+}
+
+} // namespace
+
+int main() {
+  for (const std::size_t num_orders :
+       {std::size_t{1} << 16, std::size_t{1} << 20}) {
+    run_deep_sweep(num_orders);
+  }
+  for (const price_t num_levels : {price_t{8}, price_t{4096}}) {
+    const PriceBand band{kBasePrice, 1, num_levels + 1};
+    run<OrderHeapBook>("order-heap", num_levels,
+                       [] { return std::make_unique<OrderHeapBook>(); });
+    run<MapOrderBook>("map", num_levels,
+                      [] { return std::make_unique<MapOrderBook>(); });
+    run<HeapOrderBook>("level-heap", num_levels,
+                       [] { return std::make_unique<HeapOrderBook>(); });
+    run<FlatOrderBook>("flat", num_levels,
+                       [] { return std::make_unique<FlatOrderBook>(); });
+    run<DenseOrderBook>("dense", num_levels, [&] {
+      return std::make_unique<DenseOrderBook>(band);
+    });
+    run<HybridOrderBook>("hybrid", num_levels, [&] {
+      return std::make_unique<HybridOrderBook>(
+          HybridLadderConfig{1, num_levels});
+    });
+  }
+  return 0;
+}
\ No newline at end of file
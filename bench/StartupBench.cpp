@@ -0,0 +1,118 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "misc/BenchUtilities.h"
+
+#include "clob/Market.h"
+#include "clob/ReferenceFile.h"
+
+using namespace clob;
+
+namespace {
+
+constexpr std::size_t kRepetitions{5};
+constexpr std::size_t kSymbols{100000};
+
+/**
+ * @brief Make the i-th of a set of distinct tickers.
+ */
+std::string make_ticker(std::size_t i) {
+  std::string ticker;
+  do {
+    ticker.push_back(static_cast<char>('A' + i % 26));
+    i /= 26;
+  } while (i != 0);
+  return ticker;
+}
+
+/**
+ * @brief Write the same universe as CSV and as a binary reference file.
+ */
+void write_universe(const std::string &csv_path, const std::string &bin_path) {
+  std::vector<std::string> names;
+  std::vector<std::string> tickers;
+  std::vector<ReferenceRecord> records;
+  for (std::size_t i = 0; i < kSymbols; ++i) {
+    names.push_back("Instrument " + std::to_string(i) + " Common Stock");
+    tickers.push_back(make_ticker(i));
+  }
+  std::ofstream csv{csv_path};
+  csv << "name,ticker,tick_size,lot_size\n";
+  for (std::size_t i = 0; i < kSymbols; ++i) {
+    csv << names[i] << ',' << tickers[i] << ",1,100\n";
+    records.push_back({names[i], tickers[i], 1, 100});
+  }
+  ReferenceFile::write(bin_path, records);
+}
+
+/**
+ * @brief Time building a market from a CSV file read line by line into
+ * strings and added one add_stock call at a time.
+ */
+void run_add_stock(const std::string &csv_path) {
+  std::unique_ptr<Market> market;
+  const double ns = bench::best_of_ns(
+      kRepetitions, [&] { market = std::make_unique<Market>("bench", "BNCH"); },
+      [&] {
+        std::ifstream csv{csv_path};
+        std::string line;
+        std::getline(csv, line);
+        while (std::getline(csv, line)) {
+          const std::size_t comma = line.find(',');
+          const std::size_t end = line.find(',', comma + 1);
+          market->add_stock(line.substr(0, comma),
+                            line.substr(comma + 1, end - comma - 1));
+        }
+      });
+  bench::do_not_optimize(market->get_num_stocks());
+  bench::report("startup/getline/add_stock", kSymbols, ns);
+}
+
+/**
+ * @brief Time building a market with load_universe, most of which is
+ * faulting in the pages of the reserved stocks and books.
+ */
+void run_load_universe(const char *name, const std::string &path,
+                       const HugePageMode mode = HugePageMode::Off) {
+  std::unique_ptr<Market> market;
+  const double ns = bench::best_of_ns(
+      kRepetitions,
+      [&] {
+        market = std::make_unique<Market>("bench", "BNCH");
+        market->set_huge_pages({mode});
+      },
+      [&] { bench::do_not_optimize(market->load_universe(path)); });
+  if (market->get_num_stocks() != kSymbols) {
+    std::printf("%s: loaded %zu of %zu symbols\n", name,
+                market->get_num_stocks(), kSymbols);
+  }
+  bench::report(name, kSymbols, ns);
+}
+
+} // namespace
+
+int main() {
+  const auto directory = std::filesystem::temp_directory_path();
+  const std::string csv_path = (directory / "clob_universe.csv").string();
+  const std::string bin_path = (directory / "clob_universe.bin").string();
+  write_universe(csv_path, bin_path);
+  run_add_stock(csv_path);
+  run_load_universe("startup/load_universe/csv", csv_path);
+  run_load_universe("startup/load_universe/binary", bin_path);
+  run_load_universe("startup/load_universe/binary/transparent", bin_path,
+                    HugePageMode::Transparent);
+  std::filesystem::remove(csv_path);
+  std::filesystem::remove(bin_path);
+  return 0;
+}
\ No newline at end of file
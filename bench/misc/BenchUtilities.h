@@ -0,0 +1,78 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace clob::bench {
+
+/**
+ * @brief Prevent the compiler from optimizing away a computed value.
+ *
+ * @param value The value to keep alive.
+ */
+template <typename T> inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T *sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * @brief Time a callable and return the elapsed nanoseconds.
+ *
+ * @param fn The callable to time.
+ * @return The elapsed time in nanoseconds.
+ */
+template <typename Fn> inline double time_ns(Fn &&fn) {
+  const auto start = std::chrono::steady_clock::now();
+  fn();
+  const auto end = std::chrono::steady_clock::now();
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+          .count());
+}
+
+/**
+ * @brief Run a callable several times and keep the fastest run.
+ *
+ * @param repetitions The number of runs.
+ * @param setup The untimed callable invoked before every run.
+ * @param fn The callable to time, invoked once per run.
+ * @return The fastest elapsed time in nanoseconds.
+ */
+template <typename Setup, typename Fn>
+inline double best_of_ns(const std::size_t repetitions, Setup &&setup,
+                         Fn &&fn) {
+  double best{0};
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    setup();
+    const double ns = time_ns(fn);
+    if (i == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Print a single benchmark result line.
+ *
+ * @param name The name of the benchmark.
+ * @param ops The number of operations performed in one run.
+ * @param ns The elapsed nanoseconds of one run.
+ */
+inline void report(const char *name, const std::size_t ops, const double ns) {
+  std::printf("%-48s %12zu ops %12.2f ns/op\n", name, ops,
+              ops == 0 ? 0.0 : ns / static_cast<double>(ops));
+}
+
+} // namespace clob::bench
\ No newline at end of file
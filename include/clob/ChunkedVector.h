@@ -0,0 +1,126 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace clob {
+
+/**
+ * @brief A growable sequence whose elements never move.
+ *
+ * @details Elements live in fixed chunks of chunk_size elements, so growing
+ * allocates one chunk and never relocates existing elements: references and
+ * pointers stay valid and T needs no move constructor. Only the table of
+ * chunk pointers is reallocated, and reserve sizes that up front as well.
+ */
+template <typename T, std::size_t chunk_size = 64> class ChunkedVector {
+  static_assert(chunk_size > 0, "chunk_size must be positive");
+
+  struct Chunk {
+    alignas(T) std::byte storage[sizeof(T) * chunk_size];
+  };
+
+  std::pmr::memory_resource *resource;
+  std::pmr::vector<Chunk *> chunks;
+  std::size_t num_elements{0};
+
+  Chunk *add_chunk() {
+    return chunks.emplace_back(
+        ::new (resource->allocate(sizeof(Chunk), alignof(Chunk))) Chunk);
+  }
+
+  T *slot(const std::size_t index) const {
+    return std::launder(reinterpret_cast<T *>(
+               chunks[index / chunk_size]->storage)) +
+           index % chunk_size;
+  }
+
+public:
+  /**
+   * @brief Construct an empty sequence.
+   *
+   * @param resource The memory resource for the chunks and the chunk table,
+   * it must outlive the sequence.
+   */
+  explicit ChunkedVector(
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : resource(resource), chunks(resource) {}
+  ChunkedVector(const ChunkedVector &) = delete;
+  ChunkedVector &operator=(const ChunkedVector &) = delete;
+
+  ~ChunkedVector() {
+    for (std::size_t i = 0; i < num_elements; ++i) {
+      slot(i)->~T();
+    }
+    for (Chunk *chunk : chunks) {
+      resource->deallocate(chunk, sizeof(Chunk), alignof(Chunk));
+    }
+  }
+
+  /**
+   * @brief Construct an element at the end.
+   *
+   * @param args The constructor arguments.
+   * @return The new element.
+   */
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (num_elements == chunks.size() * chunk_size) {
+      add_chunk();
+    }
+    T *element = ::new (static_cast<void *>(slot(num_elements)))
+        T(std::forward<Args>(args)...);
+    ++num_elements;
+    return *element;
+  }
+
+  /**
+   * @brief Allocate the chunks for at least capacity elements, touching them
+   * so that their pages are faulted in now rather than on first use.
+   *
+   * @param capacity The number of elements to hold without allocating.
+   */
+  void reserve(const std::size_t capacity) {
+    const std::size_t num_chunks = (capacity + chunk_size - 1) / chunk_size;
+    chunks.reserve(num_chunks);
+    while (chunks.size() < num_chunks) {
+      std::memset(static_cast<void *>(add_chunk()), 0, sizeof(Chunk));
+    }
+  }
+
+  T &operator[](const std::size_t index) { return *slot(index); }
+
+  const T &operator[](const std::size_t index) const { return *slot(index); }
+
+  /**
+   * @brief Get the number of elements.
+   *
+   * @return The number of elements.
+   */
+  std::size_t size() const { return num_elements; }
+
+  /**
+   * @brief Get the number of elements held without allocating.
+   *
+   * @return The capacity.
+   */
+  std::size_t capacity() const { return chunks.size() * chunk_size; }
+
+  /**
+   * @brief Check whether there are no elements.
+   *
+   * @return True if the sequence is empty.
+   */
+  bool empty() const { return num_elements == 0; }
+};
+
+} // namespace clob
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CLOB_HAS_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define CLOB_HAS_TSC 1
+#endif
+
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief Where a Clock takes its time from.
+ */
+enum class ClockMode {
+  // std::chrono::system_clock, one vDSO call per reading.
+  System,
+  // The invariant time stamp counter, calibrated against the system clock.
+  Tsc,
+  // Time set by the caller, for replay and simulation.
+  Manual,
+};
+
+/**
+ * @brief Source of the nanosecond timestamps given to orders.
+ *
+ * @details In Tsc mode a reading is one rdtsc and a fixed point multiply by
+ * the tick period, measured once per process against the system clock the
+ * first time a clock switches to Tsc, so readings stay close to the system
+ * clock, drifting by the error of the calibration. In Manual mode the time
+ * only moves when set, so a run fed the same orders and times is exactly
+ * reproducible.
+ */
+class Clock {
+  ClockMode mode{ClockMode::System};
+  timestamp_ns_t manual_ns{0};
+  std::uint64_t tsc_base{0};
+  timestamp_ns_t ns_base{0};
+  // Nanoseconds per tick, in 32.32 fixed point.
+  std::uint64_t ns_per_tick{0};
+
+#ifdef CLOB_HAS_TSC
+  timestamp_ns_t tsc_ns() const {
+    const std::uint64_t ticks = __rdtsc() - tsc_base;
+    return ns_base + (ticks >> 32) * ns_per_tick +
+           (((ticks & 0xffffffff) * ns_per_tick) >> 32);
+  }
+#endif
+
+public:
+  /**
+   * @brief Change where the clock takes its time from.
+   *
+   * @details Switching to Tsc fails where there is no invariant time stamp
+   * counter, leaving the mode unchanged. Switching to Manual starts the
+   * clock at 0.
+   *
+   * @param new_mode The mode to use.
+   * @return True if the mode has been applied.
+   */
+  bool configure(const ClockMode new_mode);
+
+  /**
+   * @brief Get the mode of the clock.
+   *
+   * @return The mode.
+   */
+  ClockMode get_mode() const { return mode; }
+
+  /**
+   * @brief Set the time of a clock in Manual mode.
+   *
+   * @param ns The time in nanoseconds.
+   * @return True if the time has been set, false if not in Manual mode.
+   */
+  bool set_time(const timestamp_ns_t ns) {
+    if (mode != ClockMode::Manual) {
+      return false;
+    }
+    manual_ns = ns;
+    return true;
+  }
+
+  /**
+   * @brief Read the clock.
+   *
+   * @return The time in nanoseconds since the epoch, or since 0 in Manual
+   * mode.
+   */
+  timestamp_ns_t now() const {
+    switch (mode) {
+    case ClockMode::Manual:
+      return manual_ns;
+#ifdef CLOB_HAS_TSC
+    case ClockMode::Tsc:
+      return tsc_ns();
+#endif
+    default:
+      return static_cast<timestamp_ns_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::system_clock::now().time_since_epoch())
+              .count());
+    }
+  }
+};
+
+} // namespace clob
\ No newline at end of file
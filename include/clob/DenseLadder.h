@@ -0,0 +1,234 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "clob/LevelBitmap.h"
+#include "clob/LimitOrder.h"
+#include "clob/PriceLevel.h"
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief The range of valid prices for a symbol.
+ *
+ * @details Prices run from min_price in steps of tick_size, num_ticks in
+ * total.
+ */
+struct PriceBand {
+  price_t min_price{0};
+  price_t tick_size{1};
+  std::size_t num_ticks{0};
+};
+
+/**
+ * @brief One side of the order book, kept as a flat array of price levels.
+ *
+ * @details Levels are indexed by (price - min_price) / tick_size and occupied
+ * levels are tracked in a LevelBitmap, so the next best level is found with a
+ * handful of bit scans instead of a tree walk. Only prices inside the band are
+ * accepted.
+ */
+template <LimitOrder::OrderType order_type,
+          typename Allocator = std::allocator<PriceLevel>>
+class DenseLadder {
+public:
+  using config_t = PriceBand;
+
+private:
+  PriceBand band;
+  std::vector<PriceLevel, Allocator> levels;
+  LevelBitmap occupied;
+  PriceLevel *best{nullptr};
+  std::size_t num_orders{0};
+  std::size_t num_occupied{0};
+
+  std::size_t index_of(const PriceLevel *level) const {
+    return static_cast<std::size_t>(level - levels.data());
+  }
+
+  bool is_better(const PriceLevel *level) const {
+    if constexpr (order_type == LimitOrder::OrderType::Bid) {
+      return level > best;
+    } else {
+      return level < best;
+    }
+  }
+
+  void release(PriceLevel *level) {
+    occupied.reset(index_of(level));
+    --num_occupied;
+    if (level != best) {
+      return;
+    }
+    std::size_t index;
+    if constexpr (order_type == LimitOrder::OrderType::Bid) {
+      index = occupied.find_last();
+    } else {
+      index = occupied.find_first();
+    }
+    best = index == LevelBitmap::npos ? nullptr : &levels[index];
+  }
+
+public:
+  /**
+   * @brief Construct an empty ladder covering a price band.
+   *
+   * @param band The band of prices the ladder accepts.
+   * @param allocator The allocator for the level array.
+   */
+  explicit DenseLadder(const PriceBand &band = {},
+                       const Allocator &allocator = Allocator())
+      : band(band), levels(band.num_ticks, allocator),
+        occupied(band.num_ticks) {
+    for (std::size_t i = 0; i < band.num_ticks; ++i) {
+      levels[i].price =
+          band.min_price + static_cast<price_t>(i) * band.tick_size;
+    }
+  }
+
+  /**
+   * @brief Check whether a price lies on a tick inside the band.
+   *
+   * @param price The price to check.
+   * @return True if the ladder has a level for the price.
+   */
+  bool accepts(const price_t price) const {
+    if (price < band.min_price || band.tick_size == 0) {
+      return false;
+    }
+    const price_t offset = price - band.min_price;
+    return offset % band.tick_size == 0 &&
+           offset / band.tick_size < band.num_ticks;
+  }
+
+  /**
+   * @brief Get the level with the best price.
+   *
+   * @return The best level, nullptr if the ladder is empty.
+   */
+  PriceLevel *best_level() { return best; }
+
+  /**
+   * @brief Get the level with the best price.
+   *
+   * @return The best level, nullptr if the ladder is empty.
+   */
+  const PriceLevel *best_level() const { return best; }
+
+  /**
+   * @brief Append an order to the level at its price.
+   * Assumes the ladder accepts the order's price.
+   *
+   * @param order The order to add.
+   */
+  void push(LimitOrder *order) {
+    PriceLevel *level =
+        &levels[(order->price - band.min_price) / band.tick_size];
+    if (level->empty()) {
+      occupied.set(index_of(level));
+      ++num_occupied;
+      if (best == nullptr || is_better(level)) {
+        best = level;
+      }
+    }
+    level->push_back(order);
+    ++num_orders;
+  }
+
+  /**
+   * @brief Remove the front order of the best level, releasing the level once
+   * it is empty.
+   * Assumes the ladder is not empty.
+   */
+  void pop() {
+    PriceLevel *level = best;
+    level->pop_front();
+    --num_orders;
+    if (level->empty()) {
+      release(level);
+    }
+  }
+
+  /**
+   * @brief Remove the best level and every order on it in one step.
+   * Assumes the ladder is not empty.
+   *
+   * @param fn Callable taking a LimitOrder *, called on each order in FIFO
+   * order once it has been unlinked.
+   */
+  template <typename Fn> void pop_level(Fn &&fn) {
+    PriceLevel *level = best;
+    num_orders -= level->order_count;
+    level->drain(fn);
+    release(level);
+  }
+
+  /**
+   * @brief Unlink a resting order, releasing its level once it is empty.
+   * Assumes the order rests in this ladder.
+   *
+   * @param order The order to remove.
+   */
+  void erase(LimitOrder *order) {
+    PriceLevel *level = order->level;
+    level->erase(order);
+    --num_orders;
+    if (level->empty()) {
+      release(level);
+    }
+  }
+
+  /**
+   * @brief Visit levels from best to worst until fn returns false.
+   *
+   * @param fn Callable taking a const PriceLevel & and returning bool.
+   */
+  template <typename Fn> void for_each_level(Fn &&fn) const {
+    if (best == nullptr) {
+      return;
+    }
+    std::size_t index = index_of(best);
+    while (fn(levels[index])) {
+      if constexpr (order_type == LimitOrder::OrderType::Bid) {
+        index = index == 0 ? LevelBitmap::npos : occupied.find_prev(index - 1);
+      } else {
+        index = occupied.find_next(index + 1);
+      }
+      if (index == LevelBitmap::npos) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of orders in the ladder.
+   *
+   * @return The number of orders.
+   */
+  std::size_t size() const { return num_orders; }
+
+  /**
+   * @brief Get the number of occupied price levels in the ladder.
+   *
+   * @return The number of levels.
+   */
+  std::size_t num_levels() const { return num_occupied; }
+
+  /**
+   * @brief Check whether the ladder holds no orders.
+   *
+   * @return True if the ladder is empty.
+   */
+  bool empty() const { return num_orders == 0; }
+};
+
+} // namespace clob
\ No newline at end of file
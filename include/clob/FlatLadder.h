@@ -0,0 +1,223 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "clob/LimitOrder.h"
+#include "clob/PriceLevel.h"
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief FlatLadder needs no configuration, every price is accepted.
+ */
+struct FlatLadderConfig {};
+
+/**
+ * @brief One side of the order book, kept as a sorted array of price levels.
+ *
+ * @details Level pointers are sorted worst first, so the best level sits at
+ * the back of the array. Most activity happens near the touch, where inserts
+ * and removals only shift a few trailing elements, and the array is walked
+ * with contiguous reads instead of pointer chasing. Level nodes are pooled and
+ * never move, so order handles stay valid while the array is reshuffled.
+ */
+template <LimitOrder::OrderType order_type,
+          typename Allocator = std::allocator<PriceLevel>>
+class FlatLadder {
+public:
+  using config_t = FlatLadderConfig;
+
+private:
+  using worse_t = std::conditional_t<order_type == LimitOrder::OrderType::Bid,
+                                     std::less<price_t>,
+                                     std::greater<price_t>>;
+  template <typename T>
+  using rebind_t =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+  using levels_t = std::vector<PriceLevel *, rebind_t<PriceLevel *>>;
+
+  levels_t levels;
+  std::deque<PriceLevel, Allocator> level_pool;
+  std::vector<PriceLevel *, rebind_t<PriceLevel *>> free_levels;
+  std::size_t num_orders{0};
+
+  typename levels_t::iterator find(const price_t price) {
+    return std::lower_bound(levels.begin(), levels.end(), price,
+                            [](const PriceLevel *level, const price_t value) {
+                              return worse_t{}(level->price, value);
+                            });
+  }
+
+  PriceLevel *acquire_level(const price_t price) {
+    if (free_levels.empty()) {
+      return &level_pool.emplace_back(price);
+    }
+    PriceLevel *level = free_levels.back();
+    free_levels.pop_back();
+    level->price = price;
+    return level;
+  }
+
+  void release(PriceLevel *level) {
+    if (levels.back() == level) {
+      levels.pop_back();
+    } else {
+      levels.erase(find(level->price));
+    }
+    free_levels.push_back(level);
+  }
+
+public:
+  explicit FlatLadder(const config_t & = {},
+                      const Allocator &allocator = Allocator())
+      : levels(allocator), level_pool(allocator), free_levels(allocator) {}
+
+  /**
+   * @brief Move the ladder; the sorted pointers stay valid as the pooled
+   * levels they point to never move.
+   */
+  FlatLadder(FlatLadder &&) noexcept = default;
+  FlatLadder &operator=(FlatLadder &&) noexcept = default;
+
+  /**
+   * @brief Check whether the ladder can hold a price.
+   *
+   * @return Always true.
+   */
+  constexpr bool accepts(const price_t) const { return true; }
+
+  /**
+   * @brief Get the level with the best price.
+   *
+   * @return The best level, nullptr if the ladder is empty.
+   */
+  PriceLevel *best_level() {
+    return levels.empty() ? nullptr : levels.back();
+  }
+
+  /**
+   * @brief Get the level with the best price.
+   *
+   * @return The best level, nullptr if the ladder is empty.
+   */
+  const PriceLevel *best_level() const {
+    return levels.empty() ? nullptr : levels.back();
+  }
+
+  /**
+   * @brief Append an order to the level at its price, creating the level if
+   * needed.
+   *
+   * @param order The order to add.
+   */
+  void push(LimitOrder *order) {
+    PriceLevel *level;
+    if (!levels.empty() && levels.back()->price == order->price) {
+      level = levels.back();
+    } else {
+      auto it = find(order->price);
+      if (it != levels.end() && (*it)->price == order->price) {
+        level = *it;
+      } else {
+        level = acquire_level(order->price);
+        levels.insert(it, level);
+      }
+    }
+    level->push_back(order);
+    ++num_orders;
+  }
+
+  /**
+   * @brief Remove the front order of the best level, releasing the level once
+   * it is empty.
+   * Assumes the ladder is not empty.
+   */
+  void pop() {
+    PriceLevel *level = levels.back();
+    level->pop_front();
+    --num_orders;
+    if (level->empty()) {
+      levels.pop_back();
+      free_levels.push_back(level);
+    }
+  }
+
+  /**
+   * @brief Remove the best level and every order on it in one step.
+   * Assumes the ladder is not empty.
+   *
+   * @param fn Callable taking a LimitOrder *, called on each order in FIFO
+   * order once it has been unlinked.
+   */
+  template <typename Fn> void pop_level(Fn &&fn) {
+    PriceLevel *level = levels.back();
+    num_orders -= level->order_count;
+    level->drain(fn);
+    levels.pop_back();
+    free_levels.push_back(level);
+  }
+
+  /**
+   * @brief Unlink a resting order, releasing its level once it is empty.
+   * Assumes the order rests in this ladder.
+   *
+   * @param order The order to remove.
+   */
+  void erase(LimitOrder *order) {
+    PriceLevel *level = order->level;
+    level->erase(order);
+    --num_orders;
+    if (level->empty()) {
+      release(level);
+    }
+  }
+
+  /**
+   * @brief Visit levels from best to worst until fn returns false.
+   *
+   * @param fn Callable taking a const PriceLevel & and returning bool.
+   */
+  template <typename Fn> void for_each_level(Fn &&fn) const {
+    for (auto it = levels.rbegin(); it != levels.rend(); ++it) {
+      if (!fn(static_cast<const PriceLevel &>(**it))) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of orders in the ladder.
+   *
+   * @return The number of orders.
+   */
+  std::size_t size() const { return num_orders; }
+
+  /**
+   * @brief Get the number of price levels in the ladder.
+   *
+   * @return The number of levels.
+   */
+  std::size_t num_levels() const { return levels.size(); }
+
+  /**
+   * @brief Check whether the ladder holds no orders.
+   *
+   * @return True if the ladder is empty.
+   */
+  bool empty() const { return num_orders == 0; }
+};
+
+} // namespace clob
\ No newline at end of file
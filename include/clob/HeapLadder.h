@@ -0,0 +1,251 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "clob/LimitOrder.h"
+#include "clob/PriceLevel.h"
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief HeapLadder needs no configuration, every price is accepted.
+ */
+struct HeapLadderConfig {};
+
+/**
+ * @brief One side of the order book, kept as a binary heap of level prices.
+ *
+ * @details Levels live in a hash map keyed by price and their prices in a
+ * binary heap with the best price on top. Emptied levels are dropped from the
+ * map at once but their heap entries are discarded lazily, when they reach the
+ * top or when stale entries outnumber live levels. Walking the levels in order
+ * sorts a copy of the prices, so depth queries are slower than on an ordered
+ * ladder.
+ */
+template <LimitOrder::OrderType order_type,
+          typename Allocator = std::allocator<PriceLevel>>
+class HeapLadder {
+public:
+  using config_t = HeapLadderConfig;
+
+private:
+  using compare_t = std::conditional_t<order_type == LimitOrder::OrderType::Bid,
+                                       std::greater<price_t>,
+                                       std::less<price_t>>;
+  using heap_compare_t =
+      std::conditional_t<order_type == LimitOrder::OrderType::Bid,
+                         std::less<price_t>, std::greater<price_t>>;
+  template <typename T>
+  using rebind_t =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+  std::unordered_map<price_t, PriceLevel, std::hash<price_t>,
+                     std::equal_to<price_t>,
+                     rebind_t<std::pair<const price_t, PriceLevel>>>
+      levels;
+  std::vector<price_t, rebind_t<price_t>> heap;
+  // Scratch heap of positions in heap, for walks in price order.
+  mutable std::vector<std::size_t, rebind_t<std::size_t>> frontier;
+  PriceLevel *best{nullptr};
+  std::size_t num_orders{0};
+
+  void rebuild() {
+    heap.clear();
+    for (const auto &[price, level] : levels) {
+      heap.push_back(price);
+    }
+    std::make_heap(heap.begin(), heap.end(), heap_compare_t{});
+  }
+
+  void release(PriceLevel *level) {
+    const bool was_best = level == best;
+    levels.erase(level->price);
+    if (heap.size() > 2 * levels.size() + 16) {
+      rebuild();
+    }
+    if (!was_best) {
+      return;
+    }
+    best = nullptr;
+    while (!heap.empty()) {
+      auto it = levels.find(heap.front());
+      if (it != levels.end()) {
+        best = &it->second;
+        return;
+      }
+      std::pop_heap(heap.begin(), heap.end(), heap_compare_t{});
+      heap.pop_back();
+    }
+  }
+
+public:
+  explicit HeapLadder(const config_t & = {},
+                      const Allocator &allocator = Allocator())
+      : levels(allocator), heap(allocator), frontier(allocator) {}
+
+  /**
+   * @brief Check whether the ladder can hold a price.
+   *
+   * @return Always true.
+   */
+  constexpr bool accepts(const price_t) const { return true; }
+
+  /**
+   * @brief Get the level with the best price.
+   *
+   * @return The best level, nullptr if the ladder is empty.
+   */
+  PriceLevel *best_level() { return best; }
+
+  /**
+   * @brief Get the level with the best price.
+   *
+   * @return The best level, nullptr if the ladder is empty.
+   */
+  const PriceLevel *best_level() const { return best; }
+
+  /**
+   * @brief Append an order to the level at its price, creating the level if
+   * needed.
+   *
+   * @param order The order to add.
+   */
+  void push(LimitOrder *order) {
+    PriceLevel *level;
+    if (best != nullptr && best->price == order->price) {
+      level = best;
+    } else {
+      auto [it, inserted] = levels.try_emplace(order->price, order->price);
+      level = &it->second;
+      if (inserted) {
+        heap.push_back(order->price);
+        std::push_heap(heap.begin(), heap.end(), heap_compare_t{});
+        if (best == nullptr || compare_t{}(order->price, best->price)) {
+          best = level;
+        }
+      }
+    }
+    level->push_back(order);
+    ++num_orders;
+  }
+
+  /**
+   * @brief Remove the front order of the best level, releasing the level once
+   * it is empty.
+   * Assumes the ladder is not empty.
+   */
+  void pop() {
+    PriceLevel *level = best;
+    level->pop_front();
+    --num_orders;
+    if (level->empty()) {
+      release(level);
+    }
+  }
+
+  /**
+   * @brief Remove the best level and every order on it in one step.
+   * Assumes the ladder is not empty.
+   *
+   * @param fn Callable taking a LimitOrder *, called on each order in FIFO
+   * order once it has been unlinked.
+   */
+  template <typename Fn> void pop_level(Fn &&fn) {
+    PriceLevel *level = best;
+    num_orders -= level->order_count;
+    level->drain(fn);
+    release(level);
+  }
+
+  /**
+   * @brief Unlink a resting order, releasing its level once it is empty.
+   * Assumes the order rests in this ladder.
+   *
+   * @param order The order to remove.
+   */
+  void erase(LimitOrder *order) {
+    PriceLevel *level = order->level;
+    level->erase(order);
+    --num_orders;
+    if (level->empty()) {
+      release(level);
+    }
+  }
+
+  /**
+   * @brief Visit levels from best to worst until fn returns false.
+   *
+   * @details The heap is walked best first through a frontier of the
+   * children of visited entries, so visiting k levels costs O(k log k)
+   * whatever the number of levels, and allocates nothing once the frontier
+   * has grown. Stale and duplicate heap entries are skipped.
+   *
+   * @param fn Callable taking a const PriceLevel & and returning bool.
+   */
+  template <typename Fn> void for_each_level(Fn &&fn) const {
+    auto worse = [this](const std::size_t lhs, const std::size_t rhs) {
+      return heap_compare_t{}(heap[lhs], heap[rhs]);
+    };
+    frontier.clear();
+    if (!heap.empty()) {
+      frontier.push_back(0);
+    }
+    const PriceLevel *last{nullptr};
+    while (!frontier.empty()) {
+      std::pop_heap(frontier.begin(), frontier.end(), worse);
+      const std::size_t i = frontier.back();
+      frontier.pop_back();
+      for (const std::size_t child : {2 * i + 1, 2 * i + 2}) {
+        if (child < heap.size()) {
+          frontier.push_back(child);
+          std::push_heap(frontier.begin(), frontier.end(), worse);
+        }
+      }
+      auto it = levels.find(heap[i]);
+      if (it == levels.end() || &it->second == last) {
+        continue;
+      }
+      last = &it->second;
+      if (!fn(*last)) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of orders in the ladder.
+   *
+   * @return The number of orders.
+   */
+  std::size_t size() const { return num_orders; }
+
+  /**
+   * @brief Get the number of price levels in the ladder.
+   *
+   * @return The number of levels.
+   */
+  std::size_t num_levels() const { return levels.size(); }
+
+  /**
+   * @brief Check whether the ladder holds no orders.
+   *
+   * @return True if the ladder is empty.
+   */
+  bool empty() const { return num_orders == 0; }
+};
+
+} // namespace clob
\ No newline at end of file
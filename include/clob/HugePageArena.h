@@ -0,0 +1,210 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief How a HugePageArena asks for huge pages.
+ */
+enum class HugePageMode {
+  // Normal pages only.
+  Off,
+  // Normal pages advised to the kernel for transparent huge pages.
+  Transparent,
+  // Pages from the reserved huge page pool, falling back to Transparent.
+  Explicit,
+};
+
+/**
+ * @brief Configuration of a HugePageArena.
+ *
+ * @details page_size is 2MB or 1GB and region_size is rounded up to it.
+ */
+struct HugePageConfig {
+  HugePageMode mode{HugePageMode::Off};
+  std::size_t page_size{std::size_t{2} << 20};
+  std::size_t region_size{std::size_t{16} << 20};
+};
+
+/**
+ * @brief How the memory of a HugePageArena is backed.
+ *
+ * @details huge_pages come from the reserved pool and are huge for certain;
+ * transparent_pages are huge page sized ranges advised to the kernel, which
+ * may or may not back them with huge pages; normal_pages are base pages that
+ * were never offered as huge pages.
+ */
+struct HugePageStats {
+  std::size_t page_size;
+  std::size_t huge_pages;
+  std::size_t transparent_pages;
+  std::size_t normal_pages;
+};
+
+/**
+ * @brief A memory arena carved out of large regions mapped with huge pages
+ * when possible.
+ *
+ * @details Regions are mapped as needed and only returned when the arena is
+ * destroyed. Blocks are handed out bump-pointer style and recycled: blocks of
+ * up to 4096 bytes through free lists of power of two size classes, so node
+ * based containers reuse memory instead of growing the arena, and larger
+ * blocks, rounded to 4096 bytes, best fit from the free ones, split if
+ * larger, merged with free neighbours of the same region when returned, and
+ * handed back to the bump pointer when they end at it. Every
+ * failure to get huge pages falls back silently, first to transparent huge
+ * pages, then to normal pages, and to the global heap where nothing can be
+ * mapped. Blocks are allocated and returned through the
+ * std::pmr::memory_resource interface, with alignments of at most 4096 bytes.
+ * An arena is not synchronised: give each thread its own.
+ */
+class HugePageArena : public std::pmr::memory_resource {
+  struct Region {
+    std::byte *data;
+    std::size_t size;
+    HugePageMode backing;
+    bool mapped;
+  };
+
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  static constexpr std::size_t base_page_size{4096};
+  static constexpr std::size_t min_block{sizeof(FreeBlock)};
+  static constexpr std::size_t num_classes{13};
+
+  HugePageConfig config;
+  std::vector<Region> regions;
+  FreeBlock *free_lists[num_classes]{};
+  // Free blocks over base_page_size, sorted by address.
+  std::vector<std::pair<std::byte *, std::size_t>> large_free;
+  std::byte *cursor{nullptr};
+  std::byte *end{nullptr};
+  std::size_t bytes_in_use{0};
+
+  static std::size_t size_class(const std::size_t bytes) {
+    return static_cast<std::size_t>(
+        std::bit_width(std::bit_ceil(bytes < min_block ? min_block : bytes) -
+                       1));
+  }
+
+  void map_region(const std::size_t min_size, const std::size_t alignment);
+  std::byte *bump(const std::size_t bytes, const std::size_t alignment);
+  void *take_large(const std::size_t size);
+  void give_large(std::byte *block, std::size_t size);
+  bool is_region_start(const std::byte *address) const;
+
+public:
+  /**
+   * @brief Construct an empty arena, nothing is mapped until the first
+   * allocation.
+   *
+   * @param config The huge page mode, page size and region size.
+   */
+  explicit HugePageArena(const HugePageConfig &config = {});
+  HugePageArena(const HugePageArena &) = delete;
+  HugePageArena &operator=(const HugePageArena &) = delete;
+  ~HugePageArena();
+
+  /**
+   * @brief Change the configuration of an arena that has not mapped anything
+   * yet.
+   *
+   * @param config The new configuration.
+   * @return True if the configuration has been applied.
+   */
+  bool configure(const HugePageConfig &config);
+
+  /**
+   * @brief Get the number of bytes handed out and not yet returned.
+   *
+   * @return The bytes in use.
+   */
+  std::size_t size() const { return bytes_in_use; }
+
+  /**
+   * @brief Get the number of regions mapped so far.
+   *
+   * @return The number of regions.
+   */
+  std::size_t num_regions() const { return regions.size(); }
+
+  /**
+   * @brief Get how the mapped memory is backed.
+   *
+   * @return The page counts by backing.
+   */
+  HugePageStats stats() const;
+
+protected:
+  void *do_allocate(const std::size_t bytes,
+                    const std::size_t alignment) override;
+  void do_deallocate(void *block, const std::size_t bytes,
+                     const std::size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override {
+    return this == &other;
+  }
+};
+
+/**
+ * @brief Standard allocator drawing from a HugePageArena.
+ *
+ * @details The allocator does not own the arena. Copies share it, and it
+ * must outlive every container using it and be used from one thread only.
+ * There is no default arena, so the arena is always passed in.
+ */
+template <typename T> class HugePageAllocator {
+  template <typename U> friend class HugePageAllocator;
+
+  HugePageArena *arena;
+
+public:
+  using value_type = T;
+
+  /**
+   * @brief Construct an allocator for an arena.
+   *
+   * @param arena The arena to allocate from.
+   */
+  explicit HugePageAllocator(HugePageArena *arena) : arena(arena) {}
+
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U> &other) : arena(other.arena) {}
+
+  T *allocate(const std::size_t n) {
+    return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *p, const std::size_t n) {
+    arena->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  /**
+   * @brief Get the arena the allocator draws from.
+   *
+   * @return The arena.
+   */
+  HugePageArena *get_arena() const { return arena; }
+
+  template <typename U>
+  bool operator==(const HugePageAllocator<U> &other) const {
+    return arena == other.arena;
+  }
+};
+
+} // namespace clob
\ No newline at end of file
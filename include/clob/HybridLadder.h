@@ -0,0 +1,415 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "clob/LevelBitmap.h"
+#include "clob/LimitOrder.h"
+#include "clob/PriceLevel.h"
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief Configuration of a HybridLadder.
+ *
+ * @details window_ticks is rounded up to a power of two. Each side holds
+ * window_ticks level pointers and a bitmap of as many bits, about 2KB with
+ * the default, allocated on the first order so that books without orders
+ * cost no window at all.
+ */
+struct HybridLadderConfig {
+  price_t tick_size{1};
+  std::size_t window_ticks{256};
+};
+
+/**
+ * @brief One side of the order book, kept as a dense window around the touch
+ * and a sparse tail for far away levels.
+ *
+ * @details The window is a ring buffer of level slots covering window_ticks
+ * consecutive ticks, indexed by tick modulo the window size and tracked in a
+ * LevelBitmap. Levels outside the window live in an ordered map. The best
+ * level is always inside the window; when it moves out, the window is
+ * recentered on it and levels migrate between the window and the tail. Level
+ * nodes are pooled and never move, so order handles stay valid across
+ * migrations.
+ */
+template <LimitOrder::OrderType order_type,
+          typename Allocator = std::allocator<PriceLevel>>
+class HybridLadder {
+public:
+  using config_t = HybridLadderConfig;
+
+private:
+  using tick_t = int_fast64_t;
+  using compare_t = std::conditional_t<order_type == LimitOrder::OrderType::Bid,
+                                       std::greater<price_t>,
+                                       std::less<price_t>>;
+  template <typename T>
+  using rebind_t =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+  price_t tick_size;
+  std::size_t window_mask;
+  tick_t window_low{0};
+  std::vector<PriceLevel *, rebind_t<PriceLevel *>> window;
+  LevelBitmap window_occupied;
+  std::map<price_t, PriceLevel *, compare_t,
+           rebind_t<std::pair<const price_t, PriceLevel *>>>
+      tail;
+  std::deque<PriceLevel, Allocator> level_pool;
+  std::vector<PriceLevel *, rebind_t<PriceLevel *>> free_levels;
+  PriceLevel *best{nullptr};
+  std::size_t num_orders{0};
+  std::size_t num_window_levels{0};
+
+  tick_t tick_of(const price_t price) const {
+    return static_cast<tick_t>(price / tick_size);
+  }
+
+  std::size_t slot_of(const tick_t tick) const {
+    return static_cast<std::size_t>(tick) & window_mask;
+  }
+
+  bool in_window(const tick_t tick) const {
+    return tick >= window_low &&
+           tick < window_low + static_cast<tick_t>(window.size());
+  }
+
+  bool is_better(const price_t lhs, const price_t rhs) const {
+    return compare_t{}(lhs, rhs);
+  }
+
+  PriceLevel *acquire_level(const price_t price) {
+    if (free_levels.empty()) {
+      return &level_pool.emplace_back(price);
+    }
+    PriceLevel *level = free_levels.back();
+    free_levels.pop_back();
+    level->price = price;
+    return level;
+  }
+
+  PriceLevel *find_window_best() const {
+    std::size_t slot;
+    if constexpr (order_type == LimitOrder::OrderType::Bid) {
+      const std::size_t high =
+          slot_of(window_low + static_cast<tick_t>(window_mask));
+      slot = window_occupied.find_prev(high);
+      if (slot == LevelBitmap::npos) {
+        slot = window_occupied.find_last();
+      }
+    } else {
+      slot = window_occupied.find_next(slot_of(window_low));
+      if (slot == LevelBitmap::npos) {
+        slot = window_occupied.find_first();
+      }
+    }
+    return slot == LevelBitmap::npos ? nullptr : window[slot];
+  }
+
+  /**
+   * @brief Move the window so that it covers anchor near its touch edge,
+   * migrating levels between the window and the tail.
+   */
+  void recenter(const tick_t anchor) {
+    const tick_t size = static_cast<tick_t>(window.size());
+    tick_t low;
+    if constexpr (order_type == LimitOrder::OrderType::Bid) {
+      low = anchor + size / 4 - size + 1;
+    } else {
+      low = anchor - size / 4;
+    }
+    // Keep the window within the ticks a price_t can reach.
+    const tick_t max_tick = tick_of(std::numeric_limits<price_t>::max());
+    if (low > max_tick - size + 1) {
+      low = max_tick - size + 1;
+    }
+    if (low < 0) {
+      low = 0;
+    }
+    window_low = low;
+
+    for (std::size_t slot = window_occupied.find_first();
+         slot != LevelBitmap::npos;
+         slot = window_occupied.find_next(slot + 1)) {
+      PriceLevel *level = window[slot];
+      if (!in_window(tick_of(level->price))) {
+        tail.emplace(level->price, level);
+        window[slot] = nullptr;
+        window_occupied.reset(slot);
+        --num_window_levels;
+      }
+    }
+
+    const price_t low_price = static_cast<price_t>(window_low) * tick_size;
+    const tick_t high = window_low + size - 1;
+    const price_t high_price =
+        static_cast<price_t>(high < max_tick ? high : max_tick) * tick_size;
+    auto first = tail.lower_bound(order_type == LimitOrder::OrderType::Bid
+                                      ? high_price
+                                      : low_price);
+    auto last = tail.upper_bound(order_type == LimitOrder::OrderType::Bid
+                                     ? low_price
+                                     : high_price);
+    for (auto it = first; it != last; ++it) {
+      const std::size_t slot = slot_of(tick_of(it->first));
+      window[slot] = it->second;
+      window_occupied.set(slot);
+      ++num_window_levels;
+    }
+    tail.erase(first, last);
+  }
+
+  void release(PriceLevel *level) {
+    const tick_t tick = tick_of(level->price);
+    if (in_window(tick)) {
+      const std::size_t slot = slot_of(tick);
+      window[slot] = nullptr;
+      window_occupied.reset(slot);
+      --num_window_levels;
+    } else {
+      tail.erase(level->price);
+    }
+    free_levels.push_back(level);
+    if (level != best) {
+      return;
+    }
+    best = find_window_best();
+    if (best == nullptr && !tail.empty()) {
+      recenter(tick_of(tail.begin()->first));
+      best = find_window_best();
+    }
+  }
+
+public:
+  /**
+   * @brief Construct an empty ladder.
+   *
+   * @param config The tick size and window size of the ladder.
+   * @param allocator The allocator for the window, tail and level nodes.
+   */
+  explicit HybridLadder(const HybridLadderConfig &config = {},
+                        const Allocator &allocator = Allocator())
+      : tick_size(config.tick_size),
+        window_mask(std::bit_ceil(config.window_ticks == 0
+                                      ? std::size_t{1}
+                                      : config.window_ticks) -
+                    1),
+        window(allocator), tail(allocator),
+        level_pool(allocator), free_levels(allocator) {}
+
+  /**
+   * @brief Move the ladder; the window slots, tail entries and best keep
+   * pointing at the same pooled levels.
+   */
+  HybridLadder(HybridLadder &&) noexcept = default;
+  HybridLadder &operator=(HybridLadder &&) noexcept = default;
+
+  /**
+   * @brief Check whether a price lies on a tick.
+   *
+   * @param price The price to check.
+   * @return True if the ladder can hold the price.
+   */
+  bool accepts(const price_t price) const {
+    return tick_size != 0 && price % tick_size == 0;
+  }
+
+  /**
+   * @brief Get the level with the best price.
+   *
+   * @return The best level, nullptr if the ladder is empty.
+   */
+  PriceLevel *best_level() { return best; }
+
+  /**
+   * @brief Get the level with the best price.
+   *
+   * @return The best level, nullptr if the ladder is empty.
+   */
+  const PriceLevel *best_level() const { return best; }
+
+  /**
+   * @brief Append an order to the level at its price, creating the level if
+   * needed and recentering the window if the order improves the touch from
+   * outside it.
+   * Assumes the ladder accepts the order's price.
+   *
+   * @param order The order to add.
+   */
+  void push(LimitOrder *order) {
+    if (window.empty()) {
+      window.assign(window_mask + 1, nullptr);
+      window_occupied = LevelBitmap(window_mask + 1);
+    }
+    const tick_t tick = tick_of(order->price);
+    const bool improves =
+        best == nullptr || is_better(order->price, best->price);
+    if (improves && !in_window(tick)) {
+      recenter(tick);
+    }
+
+    PriceLevel *level;
+    if (in_window(tick)) {
+      const std::size_t slot = slot_of(tick);
+      level = window[slot];
+      if (level == nullptr) {
+        level = acquire_level(order->price);
+        window[slot] = level;
+        window_occupied.set(slot);
+        ++num_window_levels;
+      }
+    } else {
+      auto [it, inserted] = tail.try_emplace(order->price, nullptr);
+      if (inserted) {
+        it->second = acquire_level(order->price);
+      }
+      level = it->second;
+    }
+    if (improves) {
+      best = level;
+    }
+    level->push_back(order);
+    ++num_orders;
+  }
+
+  /**
+   * @brief Remove the front order of the best level, releasing the level once
+   * it is empty.
+   * Assumes the ladder is not empty.
+   */
+  void pop() {
+    PriceLevel *level = best;
+    level->pop_front();
+    --num_orders;
+    if (level->empty()) {
+      release(level);
+    }
+  }
+
+  /**
+   * @brief Remove the best level and every order on it in one step.
+   * Assumes the ladder is not empty.
+   *
+   * @param fn Callable taking a LimitOrder *, called on each order in FIFO
+   * order once it has been unlinked.
+   */
+  template <typename Fn> void pop_level(Fn &&fn) {
+    PriceLevel *level = best;
+    num_orders -= level->order_count;
+    level->drain(fn);
+    release(level);
+  }
+
+  /**
+   * @brief Unlink a resting order, releasing its level once it is empty.
+   * Assumes the order rests in this ladder.
+   *
+   * @param order The order to remove.
+   */
+  void erase(LimitOrder *order) {
+    PriceLevel *level = order->level;
+    level->erase(order);
+    --num_orders;
+    if (level->empty()) {
+      release(level);
+    }
+  }
+
+  /**
+   * @brief Visit levels from best to worst until fn returns false.
+   *
+   * @param fn Callable taking a const PriceLevel & and returning bool.
+   */
+  template <typename Fn> void for_each_level(Fn &&fn) const {
+    const std::size_t first =
+        slot_of(order_type == LimitOrder::OrderType::Bid
+                    ? window_low + static_cast<tick_t>(window_mask)
+                    : window_low);
+    std::size_t visited{0};
+    std::size_t slot = first;
+    while (visited < num_window_levels) {
+      if constexpr (order_type == LimitOrder::OrderType::Bid) {
+        slot = window_occupied.find_prev(slot);
+        if (slot == LevelBitmap::npos) {
+          slot = window_occupied.find_last();
+        }
+      } else {
+        slot = window_occupied.find_next(slot);
+        if (slot == LevelBitmap::npos) {
+          slot = window_occupied.find_first();
+        }
+      }
+      if (!fn(static_cast<const PriceLevel &>(*window[slot]))) {
+        return;
+      }
+      ++visited;
+      if constexpr (order_type == LimitOrder::OrderType::Bid) {
+        slot = (slot - 1) & window_mask;
+      } else {
+        slot = (slot + 1) & window_mask;
+      }
+    }
+    for (const auto &[price, level] : tail) {
+      if (!fn(static_cast<const PriceLevel &>(*level))) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of orders in the ladder.
+   *
+   * @return The number of orders.
+   */
+  std::size_t size() const { return num_orders; }
+
+  /**
+   * @brief Get the number of price levels in the ladder.
+   *
+   * @return The number of levels.
+   */
+  std::size_t num_levels() const { return num_window_levels + tail.size(); }
+
+  /**
+   * @brief Get the number of price levels held in the sparse tail.
+   *
+   * @return The number of tail levels.
+   */
+  std::size_t num_tail_levels() const { return tail.size(); }
+
+  /**
+   * @brief Get the lowest price covered by the dense window.
+   *
+   * @return The lowest window price.
+   */
+  price_t window_min_price() const {
+    return static_cast<price_t>(window_low) * tick_size;
+  }
+
+  /**
+   * @brief Check whether the ladder holds no orders.
+   *
+   * @return True if the ladder is empty.
+   */
+  bool empty() const { return num_orders == 0; }
+};
+
+} // namespace clob
\ No newline at end of file
@@ -0,0 +1,210 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace clob {
+
+/**
+ * @brief A three level bitset tracking which price levels are occupied.
+ *
+ * @details Every bit of a summary word marks a non-empty word one level down,
+ * so the first or last set bit is found with one count-zeros instruction per
+ * level instead of a scan over the whole range.
+ */
+class LevelBitmap {
+  static constexpr std::size_t word_bits{64};
+  static constexpr std::size_t word_shift{6};
+
+  std::size_t num_bits;
+  std::vector<uint64_t> leaves;
+  std::vector<uint64_t> middle;
+  std::vector<uint64_t> top;
+
+  static constexpr std::size_t words_for(const std::size_t bits) {
+    return (bits + word_bits - 1) >> word_shift;
+  }
+
+  static constexpr uint64_t bit(const std::size_t index) {
+    return uint64_t{1} << (index & (word_bits - 1));
+  }
+
+  /**
+   * @brief Mask of the bits strictly above index within its word.
+   */
+  static constexpr uint64_t above(const std::size_t index) {
+    return (index & (word_bits - 1)) == word_bits - 1
+               ? 0
+               : ~uint64_t{0} << ((index & (word_bits - 1)) + 1);
+  }
+
+  /**
+   * @brief Mask of the bits strictly below index within its word.
+   */
+  static constexpr uint64_t below(const std::size_t index) {
+    return bit(index) - 1;
+  }
+
+  static std::size_t lowest(const std::size_t word_index, const uint64_t word) {
+    return (word_index << word_shift) +
+           static_cast<std::size_t>(std::countr_zero(word));
+  }
+
+  static std::size_t highest(const std::size_t word_index,
+                             const uint64_t word) {
+    return (word_index << word_shift) + (word_bits - 1) -
+           static_cast<std::size_t>(std::countl_zero(word));
+  }
+
+public:
+  static constexpr std::size_t npos{SIZE_MAX};
+
+  /**
+   * @brief Construct an empty bitmap.
+   *
+   * @param size The number of bits tracked.
+   */
+  explicit LevelBitmap(const std::size_t size = 0)
+      : num_bits(size), leaves(words_for(size)),
+        middle(words_for(leaves.size())), top(words_for(middle.size())) {}
+
+  /**
+   * @brief Get the number of bits tracked.
+   *
+   * @return The number of bits.
+   */
+  std::size_t size() const { return num_bits; }
+
+  /**
+   * @brief Check whether a bit is set.
+   *
+   * @param index The bit to check.
+   * @return True if the bit is set.
+   */
+  bool test(const std::size_t index) const {
+    return (leaves[index >> word_shift] & bit(index)) != 0;
+  }
+
+  /**
+   * @brief Set a bit.
+   *
+   * @param index The bit to set.
+   */
+  void set(const std::size_t index) {
+    const std::size_t leaf = index >> word_shift;
+    const std::size_t mid = leaf >> word_shift;
+    leaves[leaf] |= bit(index);
+    middle[mid] |= bit(leaf);
+    top[mid >> word_shift] |= bit(mid);
+  }
+
+  /**
+   * @brief Clear a bit.
+   *
+   * @param index The bit to clear.
+   */
+  void reset(const std::size_t index) {
+    const std::size_t leaf = index >> word_shift;
+    const std::size_t mid = leaf >> word_shift;
+    if ((leaves[leaf] &= ~bit(index)) != 0) {
+      return;
+    }
+    if ((middle[mid] &= ~bit(leaf)) != 0) {
+      return;
+    }
+    top[mid >> word_shift] &= ~bit(mid);
+  }
+
+  /**
+   * @brief Find the lowest set bit at or above an index.
+   *
+   * @param from The index to start from.
+   * @return The index of the set bit, npos if none is set.
+   */
+  std::size_t find_next(const std::size_t from) const {
+    if (from >= num_bits) {
+      return npos;
+    }
+    std::size_t leaf = from >> word_shift;
+    uint64_t word = leaves[leaf] & ~below(from);
+    if (word != 0) {
+      return lowest(leaf, word);
+    }
+    std::size_t mid = leaf >> word_shift;
+    word = middle[mid] & above(leaf);
+    if (word == 0) {
+      std::size_t t = mid >> word_shift;
+      word = top[t] & above(mid);
+      while (word == 0) {
+        if (++t == top.size()) {
+          return npos;
+        }
+        word = top[t];
+      }
+      mid = lowest(t, word);
+      word = middle[mid];
+    }
+    leaf = lowest(mid, word);
+    return lowest(leaf, leaves[leaf]);
+  }
+
+  /**
+   * @brief Find the highest set bit at or below an index.
+   *
+   * @param from The index to start from, clamped to the last bit.
+   * @return The index of the set bit, npos if none is set.
+   */
+  std::size_t find_prev(std::size_t from) const {
+    if (num_bits == 0) {
+      return npos;
+    }
+    if (from >= num_bits) {
+      from = num_bits - 1;
+    }
+    std::size_t leaf = from >> word_shift;
+    uint64_t word = leaves[leaf] & ~above(from);
+    if (word != 0) {
+      return highest(leaf, word);
+    }
+    std::size_t mid = leaf >> word_shift;
+    word = middle[mid] & below(leaf);
+    if (word == 0) {
+      std::size_t t = mid >> word_shift;
+      word = top[t] & below(mid);
+      while (word == 0) {
+        if (t-- == 0) {
+          return npos;
+        }
+        word = top[t];
+      }
+      mid = highest(t, word);
+      word = middle[mid];
+    }
+    leaf = highest(mid, word);
+    return highest(leaf, leaves[leaf]);
+  }
+
+  /**
+   * @brief Find the lowest set bit.
+   *
+   * @return The index of the lowest set bit, npos if none is set.
+   */
+  std::size_t find_first() const { return find_next(0); }
+
+  /**
+   * @brief Find the highest set bit.
+   *
+   * @return The index of the highest set bit, npos if none is set.
+   */
+  std::size_t find_last() const { return find_prev(npos); }
+};
+
+} // namespace clob
\ No newline at end of file
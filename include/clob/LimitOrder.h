@@ -10,23 +10,78 @@
 
 namespace clob {
 
+class PriceLevel;
+
 /**
  * @brief A class representing a limit order
  *
- * @details Includes the id, timestamp, price, and quantity of the order.
+ * @details Includes the id, sequence number, price, and quantity of the order.
+ * The sequence number is the time priority key: it is assigned in the order
+ * orders are accepted, so it is strict where timestamps can tie or step back.
+ * Resting orders are linked into the FIFO of their price level through prev
+ * and next, and keep a handle to that level so they can be unlinked in O(1).
+ *
+ * An order fills exactly one cache line. The fields read while walking and
+ * filling a level come first and share the first 32 bytes; the level handle,
+ * id, sequence number and balance follow in the second half.
  */
-class LimitOrder {
+class alignas(cache_line_size) LimitOrder {
 public:
   enum class OrderType { Bid, Ask };
+
+  /**
+   * @brief How long an order stays in the book.
+   *
+   * @details Gtc orders rest until filled or cancelled. Ioc orders fill what
+   * they can on arrival and cancel the rest. Fok orders fill completely on
+   * arrival or are cancelled without trading.
+   */
+  enum class TimeInForce { Gtc, Ioc, Fok };
+
+  /**
+   * @brief What happens to a post-only order that would cross on arrival.
+   *
+   * @details Reject cancels it. Slide reprices it one tick behind the best
+   * opposite price, so it rests at the touch without trading.
+   */
+  enum class PostOnly { Reject, Slide };
   using id_t = uint_fast64_t;
 
+  /**
+   * @brief Price-time priority: orders at a level are filled in FIFO order.
+   *
+   * @details A matching policy provides match(level, quantity, fill), which
+   * allocates min(quantity, open quantity of the level) among the level's
+   * orders by calling fill(order, allocation) once per allocation, and
+   * returns the quantity allocated. fill may unlink the order and release the
+   * level, so the level must not be touched after the fill that empties it.
+   * The order book owns one instance of its policy, so a policy may keep
+   * scratch state between calls. See also ProRataPriority and
+   * FifoProRataPriority.
+   */
   class PriceTimeQueuePriority {
   public:
+    template <typename Level, typename Fill>
+    static quantity_t match(Level &level, const quantity_t quantity,
+                            Fill &&fill) {
+      quantity_t remaining{quantity};
+      LimitOrder *order = level.front();
+      while (order != nullptr && remaining != 0) {
+        LimitOrder *next = order->next;
+        const quantity_t open = order->quantity - order->filled_quantity;
+        const quantity_t allocation = open < remaining ? open : remaining;
+        remaining -= allocation;
+        fill(order, allocation);
+        order = next;
+      }
+      return quantity - remaining;
+    }
+
     struct BidCmp {
       constexpr inline bool operator()(const LimitOrder *o1,
                                        const LimitOrder *o2) const {
         return o1->price < o2->price ||
-               (o1->price == o2->price && o1->timestamp > o2->timestamp);
+               (o1->price == o2->price && o1->sequence > o2->sequence);
       }
     };
 
@@ -34,23 +89,30 @@ public:
       constexpr inline bool operator()(const LimitOrder *o1,
                                        const LimitOrder *o2) const {
         return o1->price > o2->price ||
-               (o1->price == o2->price && o1->timestamp > o2->timestamp);
+               (o1->price == o2->price && o1->sequence > o2->sequence);
       }
     };
   };
 
-  id_t id;
-  timestamp_ns_t timestamp;
-  balance_t balance;
+  // Hot: read while walking and filling a level.
+  LimitOrder *prev;
+  LimitOrder *next;
   price_t price;
   quantity_t quantity;
   quantity_t filled_quantity;
   bool is_cancelled;
 
-  explicit LimitOrder(const id_t id, const timestamp_ns_t timestamp,
+  // Cold: touched on entry, exit and balance updates.
+  PriceLevel *level;
+  id_t id;
+  sequence_t sequence;
+  balance_t balance;
+
+  explicit LimitOrder(const id_t id, const sequence_t sequence,
                       const price_t price, const quantity_t quantity)
-      : id(id), timestamp(timestamp), balance(0), price(price),
-        quantity(quantity), filled_quantity(0), is_cancelled(false) {}
+      : prev(nullptr), next(nullptr), price(price), quantity(quantity),
+        filled_quantity(0), is_cancelled(false), level(nullptr), id(id),
+        sequence(sequence), balance(0) {}
 };
 
 } // namespace clob
\ No newline at end of file
@@ -6,13 +6,22 @@
 
 #pragma once
 
-#include <memory>
+#include <cstddef>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "clob/ChunkedVector.h"
+#include "clob/Clock.h"
+#include "clob/HugePageArena.h"
+#include "clob/OrderArchive.h"
 #include "clob/OrderBook.h"
+#include "clob/OrderStore.h"
 #include "clob/Stock.h"
+#include "clob/StringArena.h"
+#include "clob/TickerIndex.h"
 
 namespace clob {
 
@@ -24,11 +33,67 @@ namespace clob {
  * with the stocks.
  */
 class Market {
-  const std::string exchange_name;
-  const std::string exchange_ticker;
-  std::vector<Stock> stocks;
-  std::vector<OrderBook> order_books;
-  std::vector<std::unique_ptr<LimitOrder>> orders;
+public:
+  using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+private:
+  HugePageArena arena;
+  std::pmr::memory_resource *resource;
+  const std::pmr::string exchange_name;
+  const std::pmr::string exchange_ticker;
+  StringArena strings{resource};
+  ChunkedVector<Stock> stocks{resource};
+  TickerIndex tickers{resource};
+  ChunkedVector<OrderBook> order_books{resource};
+  OrderStore orders{resource};
+  OrderArchive archive{OrderStore::chunk_size};
+  timestamp_ns_t retention_delay_ns{0};
+  std::pmr::vector<volume_t> traded_volume{resource};
+  std::size_t order_capacity{0};
+  std::size_t reclaim_cursor{0};
+  std::size_t archive_cursor{0};
+  std::pmr::vector<ArchivedOrder> archive_buffer{resource};
+  Clock clock;
+  timestamp_ns_t event_ns{0};
+  sequence_t next_sequence{0};
+
+  /**
+   * @brief Check in O(1) whether every order of a chunk is terminal and the
+   * last became so at least the retention delay before now.
+   */
+  bool is_retired(const std::size_t chunk, const timestamp_ns_t now) const;
+
+  /**
+   * @brief List a stock under a new id and create its order book.
+   */
+  bool emplace_stock(const std::string_view stock_name,
+                     const std::string_view stock_ticker,
+                     const price_t tick_size, const quantity_t lot_size);
+
+  /**
+   * @brief Find a terminal order whose slot can be reused, sweeping the order
+   * table from where the last sweep stopped.
+   */
+  LimitOrder *find_reusable_slot();
+
+  /**
+   * @brief Mark a resting order that a trade completely filled terminal.
+   */
+  static void on_order_filled(void *context, LimitOrder *order);
+
+  /**
+   * @brief Record what a new order traded and mark it terminal unless it
+   * rests in its book.
+   */
+  void settle_order(const clob::Stock::id_t stock_id, LimitOrder *order);
+
+  /**
+   * @brief Stamp and store a new order, cancelled if its stock is unknown.
+   */
+  template <clob::LimitOrder::OrderType order_type>
+  LimitOrder *accept_order(const clob::Stock::id_t stock_id,
+                           const clob::price_t price,
+                           const clob::quantity_t quantity);
 
 public:
   Market() = delete;
@@ -38,37 +103,57 @@ public:
   Market &operator=(Market &&) = delete;
 
   /**
-   * @brief Constructor for the Market class.
+   * @brief Constructor for the Market class, its orders and levels are drawn
+   * from the market's own HugePageArena.
    *
    * @param exchange_name The name of the market.
    * @param exchange_ticker The ticker of the market.
    */
-  Market(const std::string &exchange_name, const std::string &exchange_ticker)
-      : exchange_name(exchange_name), exchange_ticker(exchange_ticker) {}
+  Market(const std::string_view exchange_name,
+         const std::string_view exchange_ticker)
+      : resource(&arena), exchange_name(exchange_name, resource),
+        exchange_ticker(exchange_ticker, resource) {}
 
   /**
-   * @brief Constructor for the Market class.
+   * @brief Constructor for the Market class drawing every container of the
+   * market, its order books and its orders from a memory resource.
    *
-   * @param name The name of the market.
-   * @param ticker The ticker of the market.
+   * @details The resource must outlive the market. Destroying the market
+   * still returns each allocation to the resource, so a
+   * std::pmr::monotonic_buffer_resource turns that into no-ops and frees the
+   * whole market with one release.
+   *
+   * @param exchange_name The name of the market.
+   * @param exchange_ticker The ticker of the market.
+   * @param allocator The allocator whose resource backs the market.
    */
-  Market(std::string &&exchange_name, std::string &&exchange_ticker)
-      : exchange_name(std::move(exchange_name)),
-        exchange_ticker(std::move(exchange_ticker)) {}
+  Market(const std::string_view exchange_name,
+         const std::string_view exchange_ticker,
+         const allocator_type &allocator)
+      : resource(allocator.resource()),
+        exchange_name(exchange_name, resource),
+        exchange_ticker(exchange_ticker, resource) {}
+
+  /**
+   * @brief Get the allocator backing the market.
+   *
+   * @return An allocator for the market's memory resource.
+   */
+  allocator_type get_allocator() const { return allocator_type(resource); }
 
   /**
    * @brief Get the name of the market.
    *
-   * @return The name of the market.
+   * @return The name of the market, valid as long as the market.
    */
-  std::string get_exchange_name() const;
+  std::string_view get_exchange_name() const { return exchange_name; }
 
   /**
    * @brief Get the ticker of the market.
    *
-   * @return The ticker of the market.
+   * @return The ticker of the market, valid as long as the market.
    */
-  std::string get_exchange_ticker() const;
+  std::string_view get_exchange_ticker() const { return exchange_ticker; }
 
   /**
    * @brief Get the number of stocks in the market.
@@ -77,10 +162,26 @@ public:
    */
   std::size_t get_num_stocks() const;
 
+  /**
+   * @brief Allocate up front for a number of stocks and orders.
+   *
+   * @details Stocks, order books and orders live in chunked storage that
+   * never relocates, so pointers from get_order_book and query_order stay
+   * valid as the market grows. Reserving also allocates and touches the
+   * chunks themselves, so adding up to max_symbols stocks and max_orders
+   * orders never allocates order or book storage on the hot path.
+   *
+   * @param max_symbols The number of stocks to make room for.
+   * @param max_orders The number of orders to make room for.
+   */
+  void reserve(const std::size_t max_symbols, const std::size_t max_orders);
+
   /**
    * @brief Add a stock to the market.
    *
    * @param stock The stock to add.
+   * @return True if the stock has been added, false if its ticker is empty,
+   * longer than eight characters or already listed, or the stocks are frozen.
    */
   bool add_stock(const std::string &stock_name,
                  const std::string &stock_ticker);
@@ -89,33 +190,326 @@ public:
    * @brief Add a stock to the market.
    *
    * @param stock The stock to add.
+   * @return True if the stock has been added, false if its ticker is empty,
+   * longer than eight characters or already listed, or the stocks are frozen.
    */
   bool add_stock(std::string &&stock_name, std::string &&stock_ticker);
 
+  /**
+   * @brief Add every instrument of a reference data file.
+   *
+   * @details The file is memory mapped, see ReferenceFile for its binary and
+   * CSV formats. Storage for all its instruments is reserved up front, then
+   * stocks and order books are built in one pass over the records, each
+   * stock keeping its tick size and lot size. Records add_stock would reject
+   * are skipped, and loading stops at the first malformed record, keeping
+   * the stocks added before it.
+   *
+   * @param path The path of the reference data file.
+   * @return The number of stocks added.
+   */
+  std::size_t load_universe(const std::string &path);
+
+  /**
+   * @brief Freeze the universe of stocks, rebuilding the ticker index as a
+   * minimal perfect hash. No stock can be added afterwards.
+   *
+   * @return True if the stocks are frozen.
+   */
+  bool freeze_stocks() { return tickers.freeze(); }
+
+  /**
+   * @brief Find a stock by its ticker packed with TickerIndex::pack.
+   *
+   * @param ticker The packed ticker.
+   * @return The stock, nullptr if no stock has this ticker.
+   */
+  const Stock *find_stock(const TickerIndex::key_t ticker) const;
+
+  /**
+   * @brief Find a stock by its ticker.
+   *
+   * @param ticker The ticker.
+   * @return The stock, nullptr if no stock has this ticker.
+   */
+  const Stock *find_stock(const std::string_view ticker) const {
+    return find_stock(TickerIndex::pack(ticker));
+  }
+
   /**
    * @brief Add an order to the market.
+   * Assumes fewer than OrderStore::max_size() orders have been added.
+   *
+   * @details With TimeInForce::Ioc whatever does not fill on arrival is
+   * cancelled, and with TimeInForce::Fok the order is cancelled without
+   * trading unless it fills completely, see OrderBook::add_fok_bid_order.
    *
    * @param order The order to add.
    */
-  template <clob::LimitOrder::OrderType order_type>
+  template <clob::LimitOrder::OrderType order_type,
+            clob::LimitOrder::TimeInForce time_in_force =
+                clob::LimitOrder::TimeInForce::Gtc>
   clob::LimitOrder::id_t add_order(const clob::Stock::id_t stock_id,
                                    const clob::price_t price,
                                    const clob::quantity_t quantity);
 
   /**
-   * @brief Cancel an order.
+   * @brief Add a market order, filling it at any price until it is filled or
+   * the opposite side of the book is empty.
+   *
+   * @details A market order never rests: whatever cannot be filled is
+   * cancelled. Its price reads 0.
+   *
+   * @param stock_id The id of the stock to trade.
+   * @param quantity The quantity to trade.
+   * @return The id of the order.
+   */
+  template <clob::LimitOrder::OrderType order_type>
+  clob::LimitOrder::id_t add_market_order(const clob::Stock::id_t stock_id,
+                                          const clob::quantity_t quantity);
+
+  /**
+   * @brief Add a market order protected by a price band, filling it no
+   * further than band away from the best opposite price on arrival.
+   *
+   * @details The order's price is set to that protection price, and whatever
+   * cannot be filled within it is cancelled, as is the whole order if the
+   * opposite side is empty.
+   *
+   * @param stock_id The id of the stock to trade.
+   * @param quantity The quantity to trade.
+   * @param band The largest distance from the touch a fill may be at.
+   * @return The id of the order.
+   */
+  template <clob::LimitOrder::OrderType order_type>
+  clob::LimitOrder::id_t add_market_order(const clob::Stock::id_t stock_id,
+                                          const clob::quantity_t quantity,
+                                          const clob::price_t band);
+
+  /**
+   * @brief Add a post-only order, which rests without ever taking liquidity.
+   *
+   * @details An order that would cross the best opposite price on arrival is
+   * either cancelled or slid one tick behind it, as post_only says. Its price
+   * then reads the price it rests at.
+   *
+   * @param stock_id The id of the stock to trade.
+   * @param price The price to rest at.
+   * @param quantity The quantity to trade.
+   * @param post_only What to do with an order that would cross.
+   * @return The id of the order.
+   */
+  template <clob::LimitOrder::OrderType order_type>
+  clob::LimitOrder::id_t
+  add_post_only_order(const clob::Stock::id_t stock_id,
+                      const clob::price_t price,
+                      const clob::quantity_t quantity,
+                      const clob::LimitOrder::PostOnly post_only);
+
+  /**
+   * @brief Cancel an order, removing it from its order book.
    *
    * @param order_id The id of the order to cancel.
+   * @return True if the order was resting and has been cancelled.
    */
   bool cancel_order(const clob::LimitOrder::id_t order_id);
 
   /**
-   * @brief Query an order.
+   * @brief Modify the price and quantity of a resting order.
+   *
+   * @details Keeps the order's id and storage. A quantity decrease at the same
+   * price keeps time priority; a price change or quantity increase re-queues
+   * the order, matching it first if the new price crosses. A quantity at or
+   * below the filled quantity cancels the order.
+   *
+   * @param order_id The id of the order to modify.
+   * @param price The new price.
+   * @param quantity The new total quantity, including filled quantity.
+   * @return True if the order was resting and has been modified.
+   */
+  bool modify_order(const clob::LimitOrder::id_t order_id,
+                    const clob::price_t price, const clob::quantity_t quantity);
+
+  /**
+   * @brief Cancel every resting order of a stock.
+   *
+   * @details Scans the store's stock and live columns rather than walking the
+   * book, so the cost is a streaming pass over five bytes per order plus one
+   * cancel per resting order of the stock.
+   *
+   * @param stock_id The id of the stock to cancel orders for.
+   * @return The number of orders cancelled.
+   */
+  std::size_t cancel_all_orders(const clob::Stock::id_t stock_id);
+
+  /**
+   * @brief Get the quantity traded in a stock so far.
+   *
+   * @details Counted as orders trade, so the query costs one load.
+   *
+   * @param stock_id The id of the stock to report on.
+   * @return The traded quantity, each trade counted once.
+   */
+  volume_t get_traded_volume(const clob::Stock::id_t stock_id) const;
+
+  /**
+   * @brief Query an order held in memory.
    *
    * @param order_id The id of the order to query.
+   * @return The order, nullptr if there is no such order or it has been
+   * moved to the archive.
    */
   const LimitOrder *query_order(const clob::LimitOrder::id_t order_id) const;
 
+  /**
+   * @brief Read back an order moved to the archive.
+   *
+   * @param order_id The id of the order to read.
+   * @param order Set to the archived record of the order.
+   * @return True if the order has been archived, false otherwise.
+   */
+  bool query_archived_order(const clob::LimitOrder::id_t order_id,
+                            ArchivedOrder &order) const;
+
+  /**
+   * @brief Get the time an order was accepted, or last re-queued by
+   * modify_order.
+   *
+   * @details Time priority follows LimitOrder::sequence, a market wide
+   * sequence number assigned at acceptance. The wall-clock timestamp is only
+   * a record of when that happened, kept apart from the order so that
+   * matching never reads it.
+   *
+   * @param order_id The id of the order.
+   * @param timestamp Set to the timestamp of the order.
+   * @return True if the order exists, false otherwise.
+   */
+  bool get_order_timestamp(const clob::LimitOrder::id_t order_id,
+                           timestamp_ns_t &timestamp) const;
+
+  /**
+   * @brief Reuse the slots of terminal orders so that the order table stays
+   * at a fixed size.
+   *
+   * @details Once capacity orders have been added, a new order takes the slot
+   * of the next filled or cancelled order found by a sweep over the table,
+   * and the slot's generation is bumped so that the old id goes stale:
+   * cancel_order, modify_order and query_order reject it by comparing it with
+   * the id in the slot. If a sweep finds every order live, the table grows by
+   * one chunk. Cannot be combined with a retention policy.
+   *
+   * @param capacity The number of slots the table holds before reusing, 0
+   * to never reuse them.
+   * @return True if recycling has been enabled, false if orders were already
+   * added or a retention policy is set.
+   */
+  bool set_order_capacity(const std::size_t capacity);
+
+  /**
+   * @brief Move terminal orders out of memory into an append-only archive.
+   *
+   * @details Orders are retired a whole chunk of OrderStore::chunk_size
+   * consecutive ids at a time, once every order of the chunk is filled or
+   * cancelled and the last of them became so at least delay_ns ago. Retired
+   * orders are read with query_archived_order; cancelling or modifying them
+   * fails as it does for any terminal order. Retention runs whenever the
+   * store starts a new chunk and checks each chunk in O(1), skipping the
+   * retired ones before the first resident chunk.
+   *
+   * Chunks are never compacted: a single order resting for the whole session
+   * keeps its chunk of OrderStore::chunk_size records resident, so memory is
+   * bounded by one chunk per long-lived resting order on top of the recent
+   * chunks. Cannot be combined with slot reuse.
+   *
+   * @param archive_path The archive file, created or truncated.
+   * @param delay_ns The minimum time an order stays in memory once it is
+   * terminal.
+   * @return True if the archive file has been opened, false if it could not
+   * be or slot reuse is enabled.
+   */
+  bool set_retention_policy(const std::string &archive_path,
+                            const timestamp_ns_t delay_ns);
+
+  /**
+   * @brief Retire every chunk of terminal orders old enough to be archived.
+   *
+   * @return The number of orders moved to the archive.
+   */
+  std::size_t archive_terminal_orders();
+
+  /**
+   * @brief Get the number of orders moved to the archive.
+   *
+   * @return The number of archived orders.
+   */
+  std::size_t get_num_archived_orders() const { return archive.size(); }
+
+  /**
+   * @brief Back the market's orders and price levels with huge pages.
+   *
+   * @details Falls back silently to normal pages when huge pages cannot be
+   * mapped, see get_huge_page_stats for what was obtained. Must be called
+   * before the market allocates anything, and only applies to markets drawing
+   * from their own arena.
+   *
+   * @param config The huge page mode, page size and region size.
+   * @return True if the configuration has been applied.
+   */
+  bool set_huge_pages(const HugePageConfig &config) {
+    return resource == &arena && arena.configure(config);
+  }
+
+  /**
+   * @brief Get how the memory of the market's orders and levels is backed.
+   *
+   * @return The page counts by backing.
+   */
+  HugePageStats get_huge_page_stats() const { return arena.stats(); }
+
+  /**
+   * @brief Change where the market takes order timestamps from.
+   *
+   * @details Timestamps only age orders for the retention policy, time
+   * priority follows the market's sequence numbers. ClockMode::Tsc reads the
+   * time stamp counter instead of the system clock on every order;
+   * ClockMode::Manual uses the time passed to set_time, so replaying the same
+   * orders at the same times reproduces every timestamp exactly.
+   *
+   * @param mode The clock mode.
+   * @return True if the mode has been applied, false for ClockMode::Tsc
+   * where there is no invariant time stamp counter.
+   */
+  bool set_clock(const ClockMode mode) { return clock.configure(mode); }
+
+  /**
+   * @brief Set the time given to the next orders of a market whose clock is
+   * in ClockMode::Manual.
+   *
+   * @param ns The time in nanoseconds.
+   * @return True if the time has been set, false if the clock is not manual.
+   */
+  bool set_time(const timestamp_ns_t ns) { return clock.set_time(ns); }
+
+  /**
+   * @brief Read the market's clock.
+   *
+   * @return The time in nanoseconds.
+   */
+  timestamp_ns_t get_time() const { return clock.now(); }
+
+  /**
+   * @brief Get the number of order chunks held in memory.
+   *
+   * @details Orders are carved out of fixed size chunks, so this grows once
+   * per OrderStore::chunk_size orders, not with every order, and shrinks as
+   * chunks are archived.
+   *
+   * @return The number of resident order chunks.
+   */
+  std::size_t get_num_order_chunks() const {
+    return orders.num_resident_chunks();
+  }
+
   /**
    * @brief Get the order book for a stock.
    *
@@ -0,0 +1,115 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "clob/LimitOrder.h"
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief The on-disk record of a terminal order.
+ *
+ * @details Records are written as they are laid out in memory, so the layout
+ * has no padding and the reserved bytes are always zero.
+ */
+struct ArchivedOrder {
+  std::uint64_t id;
+  std::uint64_t timestamp;
+  std::uint64_t sequence;
+  std::int64_t balance;
+  std::uint32_t price;
+  std::uint32_t quantity;
+  std::uint32_t filled_quantity;
+  std::uint32_t stock_id;
+  LimitOrder::OrderType order_type;
+  bool is_cancelled;
+  std::uint8_t reserved[3]{};
+};
+
+static_assert(sizeof(ArchivedOrder) == 56 &&
+                  std::has_unique_object_representations_v<ArchivedOrder>,
+              "ArchivedOrder must have a fixed layout without padding");
+
+/**
+ * @brief Append-only file of terminal orders, written and read back in blocks
+ * of consecutive ids.
+ *
+ * @details Each block holds the orders of one id range and is appended as one
+ * write. An in-memory index keeps one file offset per block, so a lookup is
+ * one seek and one record read.
+ */
+class OrderArchive {
+  struct FileCloser {
+    void operator()(std::FILE *file) const { std::fclose(file); }
+  };
+
+  std::unique_ptr<std::FILE, FileCloser> file;
+  std::vector<std::int64_t> block_offsets;
+  std::size_t block_size;
+  std::int64_t end_offset{0};
+  std::size_t num_orders{0};
+
+public:
+  /**
+   * @brief Construct a closed archive.
+   *
+   * @param block_size The number of ids covered by a block.
+   */
+  explicit OrderArchive(const std::size_t block_size)
+      : block_size(block_size) {}
+
+  /**
+   * @brief Create or truncate the archive file.
+   *
+   * @param path The path of the file.
+   * @return True if the file has been opened.
+   */
+  bool open(const std::string &path);
+
+  /**
+   * @brief Check whether the archive has a file to write to.
+   *
+   * @return True if the archive is open.
+   */
+  bool is_open() const { return file != nullptr; }
+
+  /**
+   * @brief Append the orders of a block.
+   *
+   * @param block The index of the block, its first id divided by block_size.
+   * @param orders The orders of the block in id order, at most block_size.
+   * @return True if the block has been written.
+   */
+  bool append(const std::size_t block, std::span<const ArchivedOrder> orders);
+
+  /**
+   * @brief Read an archived order back.
+   *
+   * @param id The id of the order.
+   * @param order Receives the order.
+   * @return True if the order is archived and has been read.
+   */
+  bool read(const std::uint64_t id, ArchivedOrder &order) const;
+
+  /**
+   * @brief Get the number of orders in the archive.
+   *
+   * @return The number of archived orders.
+   */
+  std::size_t size() const { return num_orders; }
+};
+
+} // namespace clob
\ No newline at end of file
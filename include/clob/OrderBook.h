@@ -6,20 +6,81 @@
 
 #pragma once
 
-#include <queue>
-#include <vector>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <span>
 
+#include "clob/DenseLadder.h"
+#include "clob/FlatLadder.h"
+#include "clob/HeapLadder.h"
+#include "clob/HugePageArena.h"
+#include "clob/HybridLadder.h"
 #include "clob/LimitOrder.h"
+#include "clob/PriceLadder.h"
+#include "clob/ProRataPriority.h"
 
 namespace clob {
 
-class OrderBook {
-  std::priority_queue<LimitOrder *, std::vector<LimitOrder *>,
-                      LimitOrder::PriceTimeQueuePriority::BidCmp>
-      bids;
-  std::priority_queue<LimitOrder *, std::vector<LimitOrder *>,
-                      LimitOrder::PriceTimeQueuePriority::AskCmp>
-      asks;
+/**
+ * @brief Aggregated view of a single price level.
+ */
+struct DepthLevel {
+  price_t price;
+  volume_t quantity;
+  std::size_t num_orders;
+};
+
+/**
+ * @brief An order book for a single stock.
+ *
+ * @details All policies are picked at compile time:
+ * - LevelStore keeps each side's price levels. PriceLadder is an ordered map;
+ *   HeapLadder a binary heap of level prices; FlatLadder a sorted array;
+ *   DenseLadder a tick-indexed array over a bounded band; HybridLadder a dense
+ *   window around the touch with a sparse tail.
+ * - MatchingPolicy allocates an incoming order among the orders of a level:
+ *   LimitOrder::PriceTimeQueuePriority, ProRataPriority or
+ *   FifoProRataPriority.
+ * - Allocator allocates the level stores' nodes.
+ */
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy = LimitOrder::PriceTimeQueuePriority,
+          typename Allocator = std::allocator<PriceLevel>>
+class BasicOrderBook {
+public:
+  using bid_store_t = LevelStore<LimitOrder::OrderType::Bid, Allocator>;
+  using ask_store_t = LevelStore<LimitOrder::OrderType::Ask, Allocator>;
+  using config_t = typename bid_store_t::config_t;
+  using matching_policy_t = MatchingPolicy;
+  using allocator_type = Allocator;
+  using filled_handler_t = void (*)(void *context, LimitOrder *order);
+
+private:
+  bid_store_t bids;
+  ask_store_t asks;
+  MatchingPolicy matching_policy;
+  price_t tick_size;
+  filled_handler_t filled_handler{nullptr};
+  void *filled_context{nullptr};
+
+  /**
+   * @brief Get the tick of a configuration, 1 if it has none.
+   */
+  static price_t tick_of(const config_t &config) {
+    if constexpr (requires { config.tick_size; }) {
+      return config.tick_size == 0 ? 1 : config.tick_size;
+    } else {
+      return 1;
+    }
+  }
+
+  /**
+   * @brief Fill an incoming order against the opposite side, best level
+   * first, up to limit if bounded, and return its open quantity left.
+   */
+  template <LimitOrder::OrderType order_type, bool bounded>
+  quantity_t sweep(LimitOrder *new_order, const price_t limit);
 
   /**
    * @brief Match the orders in the order book.
@@ -27,9 +88,78 @@ class OrderBook {
   template <LimitOrder::OrderType order_type>
   void match_orders(LimitOrder *new_order);
 
+  /**
+   * @brief Check whether the opposite side holds enough open quantity at
+   * prices an order accepts to fill it, from the levels' aggregates alone.
+   */
+  template <LimitOrder::OrderType order_type>
+  bool can_fill(const LimitOrder *new_order) const;
+
+  /**
+   * @brief Match an immediate-or-cancel or fill-or-kill order and cancel what
+   * is left without resting it.
+   */
+  template <LimitOrder::OrderType order_type,
+            LimitOrder::TimeInForce time_in_force>
+  void match_immediate_order(LimitOrder *new_order);
+
+  /**
+   * @brief Sweep a market order, within band of the touch if band is set,
+   * and cancel what is left.
+   */
+  template <LimitOrder::OrderType order_type>
+  void match_market_order(LimitOrder *new_order, const price_t *band);
+
+  /**
+   * @brief Rest a post-only order without matching it, rejecting or sliding
+   * it if it would cross.
+   */
+  template <LimitOrder::OrderType order_type>
+  void post_order(LimitOrder *new_order, const LimitOrder::PostOnly post_only);
+
+  /**
+   * @brief Unlink a resting order from the order book.
+   */
+  template <LimitOrder::OrderType order_type>
+  bool remove_order(LimitOrder *order);
+
+  /**
+   * @brief Amend a resting order in place or re-queue it.
+   */
+  template <LimitOrder::OrderType order_type>
+  bool amend_order(LimitOrder *order, const price_t price,
+                   const quantity_t quantity, const sequence_t sequence);
+
 public:
+  /**
+   * @brief Construct an empty order book.
+   *
+   * @param config The configuration shared by both level stores.
+   * @param allocator The allocator used by both level stores.
+   */
+  explicit BasicOrderBook(const config_t &config = {},
+                          const Allocator &allocator = Allocator())
+      : bids(config, allocator), asks(config, allocator), matching_policy(),
+        tick_size(tick_of(config)) {}
+
+  /**
+   * @brief Call handler whenever a resting order is completely filled and
+   * leaves the book.
+   *
+   * @details The handler runs inside the matching loop, once the order has
+   * been unlinked; it must not modify the book.
+   *
+   * @param handler The function to call, nullptr to stop calling one.
+   * @param context The pointer passed back to handler.
+   */
+  void set_filled_handler(const filled_handler_t handler, void *context) {
+    filled_handler = handler;
+    filled_context = context;
+  }
+
   /**
    * @brief Add a bid order to the order book.
+   * Orders the level store cannot hold are cancelled.
    *
    * @param order The order to add.
    */
@@ -37,11 +167,207 @@ public:
 
   /**
    * @brief Add an ask order to the order book.
+   * Orders the level store cannot hold are cancelled.
    *
    * @param order The order to add.
    */
   void add_ask_order(LimitOrder *order);
 
+  /**
+   * @brief Add an immediate-or-cancel bid order, filling what it can against
+   * asks at or below its price and cancelling the rest.
+   *
+   * @details The rest is never pushed onto the bid side.
+   *
+   * @param order The order to add.
+   */
+  void add_ioc_bid_order(LimitOrder *order);
+
+  /**
+   * @brief Add an immediate-or-cancel ask order.
+   *
+   * @details See add_ioc_bid_order.
+   *
+   * @param order The order to add.
+   */
+  void add_ioc_ask_order(LimitOrder *order);
+
+  /**
+   * @brief Add a fill-or-kill bid order, filling it completely against asks
+   * at or below its price or cancelling it without trading.
+   *
+   * @details Whether it can be filled is decided before anything is touched,
+   * by adding up the open quantity of the ask levels within its price, a
+   * scan of at most as many levels as the order would trade with.
+   *
+   * @param order The order to add.
+   */
+  void add_fok_bid_order(LimitOrder *order);
+
+  /**
+   * @brief Add a fill-or-kill ask order.
+   *
+   * @details See add_fok_bid_order.
+   *
+   * @param order The order to add.
+   */
+  void add_fok_ask_order(LimitOrder *order);
+
+  /**
+   * @brief Add a market bid order, filling it against the asks whatever their
+   * price until it is filled or no ask is left.
+   *
+   * @details The sweep never compares prices. Whatever is left is cancelled,
+   * a market order never rests. The order's price is not read.
+   *
+   * @param order The order to add.
+   */
+  void add_market_bid_order(LimitOrder *order);
+
+  /**
+   * @brief Add a market bid order protected by a price band, filling it
+   * against the asks up to band above the best ask.
+   *
+   * @details The order's price is set to that protection price, and whatever
+   * is left at or below it is cancelled. With no ask the order is cancelled.
+   *
+   * @param order The order to add.
+   * @param band The largest distance from the best ask a fill may be at.
+   */
+  void add_market_bid_order(LimitOrder *order, const price_t band);
+
+  /**
+   * @brief Add a market ask order, filling it against the bids whatever their
+   * price until it is filled or no bid is left.
+   *
+   * @details See add_market_bid_order.
+   *
+   * @param order The order to add.
+   */
+  void add_market_ask_order(LimitOrder *order);
+
+  /**
+   * @brief Add a market ask order protected by a price band, filling it
+   * against the bids down to band below the best bid.
+   *
+   * @details See add_market_bid_order.
+   *
+   * @param order The order to add.
+   * @param band The largest distance from the best bid a fill may be at.
+   */
+  void add_market_ask_order(LimitOrder *order, const price_t band);
+
+  /**
+   * @brief Add a post-only bid order, resting it without ever taking
+   * liquidity.
+   *
+   * @details An order priced at or above the best ask is either cancelled or
+   * slid to one tick below the best ask, as post_only says. The check is a
+   * single compare against the best ask, the order is never matched. The
+   * tick is the configuration's tick_size, or 1 for stores without one.
+   *
+   * @param order The order to add.
+   * @param post_only What to do with an order that would cross.
+   */
+  void add_post_only_bid_order(LimitOrder *order,
+                               const LimitOrder::PostOnly post_only);
+
+  /**
+   * @brief Add a post-only ask order, resting it without ever taking
+   * liquidity.
+   *
+   * @details An order priced at or below the best bid is either cancelled or
+   * slid to one tick above the best bid. See add_post_only_bid_order.
+   *
+   * @param order The order to add.
+   * @param post_only What to do with an order that would cross.
+   */
+  void add_post_only_ask_order(LimitOrder *order,
+                               const LimitOrder::PostOnly post_only);
+
+  /**
+   * @brief Cancel a resting bid order, removing it from the order book in O(1).
+   *
+   * @param order The order to cancel.
+   * @return True if the order was resting and has been removed.
+   */
+  bool cancel_bid_order(LimitOrder *order);
+
+  /**
+   * @brief Cancel a resting ask order, removing it from the order book in O(1).
+   *
+   * @param order The order to cancel.
+   * @return True if the order was resting and has been removed.
+   */
+  bool cancel_ask_order(LimitOrder *order);
+
+  /**
+   * @brief Modify the price and total quantity of a resting bid order.
+   *
+   * @details A quantity decrease at the same price is applied in place and
+   * keeps time priority. Any other change re-queues the same order with the
+   * given sequence number, matching it first if the new price crosses. A
+   * quantity at or below the filled quantity cancels the order.
+   *
+   * @param order The order to modify.
+   * @param price The new price.
+   * @param quantity The new total quantity, including filled quantity.
+   * @param sequence The sequence number used if the order loses priority,
+   * above that of any order in the book.
+   * @return True if the order was resting and has been modified.
+   */
+  bool modify_bid_order(LimitOrder *order, const price_t price,
+                        const quantity_t quantity,
+                        const sequence_t sequence);
+
+  /**
+   * @brief Modify the price and total quantity of a resting ask order.
+   *
+   * @details See modify_bid_order.
+   *
+   * @param order The order to modify.
+   * @param price The new price.
+   * @param quantity The new total quantity, including filled quantity.
+   * @param sequence The sequence number used if the order loses priority,
+   * above that of any order in the book.
+   * @return True if the order was resting and has been modified.
+   */
+  bool modify_ask_order(LimitOrder *order, const price_t price,
+                        const quantity_t quantity,
+                        const sequence_t sequence);
+
+  /**
+   * @brief Get the best bid price level, with its aggregated open quantity and
+   * order count.
+   *
+   * @return The best bid level, nullptr if there are no bids.
+   */
+  const PriceLevel *get_best_bid_level() const;
+
+  /**
+   * @brief Get the best ask price level, with its aggregated open quantity and
+   * order count.
+   *
+   * @return The best ask level, nullptr if there are no asks.
+   */
+  const PriceLevel *get_best_ask_level() const;
+
+  /**
+   * @brief Fill depth with the aggregated bid levels, best first.
+   *
+   * @param depth The levels to fill, at most depth.size() are written.
+   * @return The number of levels written.
+   */
+  std::size_t get_bid_depth(std::span<DepthLevel> depth) const;
+
+  /**
+   * @brief Fill depth with the aggregated ask levels, best first.
+   *
+   * @param depth The levels to fill, at most depth.size() are written.
+   * @return The number of levels written.
+   */
+  std::size_t get_ask_depth(std::span<DepthLevel> depth) const;
+
   /**
    * @brief Get the top bid order from the order book.
    *
@@ -57,6 +383,13 @@ public:
    */
   const LimitOrder *get_best_ask_order() const;
 
+  /**
+   * @brief Get the price increment post-only orders slide by.
+   *
+   * @return The tick size.
+   */
+  price_t get_tick_size() const { return tick_size; }
+
   /**
    * @brief Get the number of bid orders.
    *
@@ -70,6 +403,71 @@ public:
    * @return The number of ask orders.
    */
   std::size_t asks_size() const { return asks.size(); }
+
+  /**
+   * @brief Get the number of bid price levels.
+   *
+   * @return The number of bid price levels.
+   */
+  std::size_t bid_levels_size() const { return bids.num_levels(); }
+
+  /**
+   * @brief Get the number of ask price levels.
+   *
+   * @return The number of ask price levels.
+   */
+  std::size_t ask_levels_size() const { return asks.num_levels(); }
 };
 
+extern template class BasicOrderBook<PriceLadder>;
+extern template class BasicOrderBook<HeapLadder>;
+extern template class BasicOrderBook<FlatLadder>;
+extern template class BasicOrderBook<DenseLadder>;
+extern template class BasicOrderBook<HybridLadder>;
+extern template class BasicOrderBook<PriceLadder, ProRataPriority<>>;
+extern template class BasicOrderBook<PriceLadder, FifoProRataPriority<>>;
+
+#ifndef CLOB_LEVEL_STORE
+#define CLOB_LEVEL_STORE PriceLadder
+#endif
+
+extern template class BasicOrderBook<CLOB_LEVEL_STORE,
+                                     LimitOrder::PriceTimeQueuePriority,
+                                     HugePageAllocator<PriceLevel>>;
+
+/**
+ * @brief An order book whose level nodes are drawn from a HugePageArena.
+ *
+ * @details Constructed with a HugePageAllocator for an arena the caller owns.
+ */
+using HugePageOrderBook =
+    BasicOrderBook<CLOB_LEVEL_STORE, LimitOrder::PriceTimeQueuePriority,
+                   HugePageAllocator<PriceLevel>>;
+
+extern template class BasicOrderBook<
+    CLOB_LEVEL_STORE, LimitOrder::PriceTimeQueuePriority,
+    std::pmr::polymorphic_allocator<PriceLevel>>;
+
+/**
+ * @brief An order book whose level nodes are drawn from a
+ * std::pmr::memory_resource.
+ */
+using PmrOrderBook =
+    BasicOrderBook<CLOB_LEVEL_STORE, LimitOrder::PriceTimeQueuePriority,
+                   std::pmr::polymorphic_allocator<PriceLevel>>;
+
+/**
+ * @brief The order book used by Market, its level store is selected by the
+ * CLOB_LEVEL_STORE build option and its level nodes come from the market's
+ * memory resource.
+ */
+using OrderBook = PmrOrderBook;
+using MapOrderBook = BasicOrderBook<PriceLadder>;
+using HeapOrderBook = BasicOrderBook<HeapLadder>;
+using FlatOrderBook = BasicOrderBook<FlatLadder>;
+using DenseOrderBook = BasicOrderBook<DenseLadder>;
+using HybridOrderBook = BasicOrderBook<HybridLadder>;
+using ProRataOrderBook = BasicOrderBook<PriceLadder, ProRataPriority<>>;
+using FifoProRataOrderBook = BasicOrderBook<PriceLadder, FifoProRataPriority<>>;
+
 } // namespace clob
\ No newline at end of file
@@ -0,0 +1,496 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "clob/OrderBook.h"
+
+/**
+ * @file
+ * @brief Member definitions of BasicOrderBook.
+ *
+ * @details The shipped level stores are instantiated in the library. Include
+ * this header to instantiate BasicOrderBook with another level store, matching
+ * policy or allocator.
+ */
+
+namespace clob {
+
+namespace detail {
+
+template <typename Side>
+std::size_t collect_depth(const Side &side, std::span<DepthLevel> depth) {
+  std::size_t count{0};
+  if (depth.empty()) {
+    return count;
+  }
+  side.for_each_level([&](const PriceLevel &level) {
+    depth[count++] = {level.price, level.total_quantity, level.order_count};
+    return count < depth.size();
+  });
+  return count;
+}
+
+} // namespace detail
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+template <LimitOrder::OrderType order_type, bool bounded>
+quantity_t BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::sweep(
+    LimitOrder *new_order, const price_t limit) {
+  using order_book_t =
+      std::conditional_t<order_type == LimitOrder::OrderType::Bid,
+                         decltype(asks), decltype(bids)>;
+  order_book_t *order_book;
+  constexpr const balance_t balance_sign{
+      order_type == LimitOrder::OrderType::Bid ? 1 : -1};
+  if constexpr (order_type == LimitOrder::OrderType::Bid) {
+    order_book = &asks;
+  } else {
+    order_book = &bids;
+  }
+
+  PriceLevel *level;
+  auto fill = [&](LimitOrder *order, const quantity_t allocation) {
+    new_order->balance -= balance_sign * allocation * level->price;
+    order->balance += balance_sign * allocation * level->price;
+    new_order->filled_quantity += allocation;
+    level->fill(order, allocation);
+    if (order->filled_quantity == order->quantity) {
+      order_book->erase(order);
+      if (filled_handler != nullptr) {
+        filled_handler(filled_context, order);
+      }
+    }
+  };
+
+  quantity_t new_order_q{new_order->quantity - new_order->filled_quantity};
+  while ((level = order_book->best_level()) != nullptr && new_order_q != 0) {
+    if constexpr (bounded && order_type == LimitOrder::OrderType::Bid) {
+      if (level->price > limit) {
+        break;
+      }
+    } else if constexpr (bounded) {
+      if (level->price < limit) {
+        break;
+      }
+    }
+
+    if (level->total_quantity <= new_order_q) {
+      // The whole level is consumed whatever the matching policy, so fill
+      // every order in one walk of the FIFO and release the level at once.
+      const price_t price = level->price;
+      volume_t swept{0};
+      order_book->pop_level([&](LimitOrder *order) {
+        const quantity_t order_q = order->quantity - order->filled_quantity;
+        order->balance += balance_sign * order_q * price;
+        order->filled_quantity = order->quantity;
+        swept += order_q;
+        if (filled_handler != nullptr) {
+          filled_handler(filled_context, order);
+        }
+      });
+      new_order->balance -=
+          balance_sign * static_cast<balance_t>(swept) * price;
+      new_order->filled_quantity += static_cast<quantity_t>(swept);
+      new_order_q -= static_cast<quantity_t>(swept);
+      continue;
+    }
+
+    new_order_q -= matching_policy.match(*level, new_order_q, fill);
+  }
+  return new_order_q;
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+template <LimitOrder::OrderType order_type>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::match_orders(
+    LimitOrder *new_order) {
+  using new_order_book_t =
+      std::conditional_t<order_type == LimitOrder::OrderType::Bid,
+                         decltype(bids), decltype(asks)>;
+  new_order_book_t *new_order_book;
+  if constexpr (order_type == LimitOrder::OrderType::Bid) {
+    new_order_book = &bids;
+  } else {
+    new_order_book = &asks;
+  }
+
+  if (new_order->is_cancelled) {
+    return;
+  }
+  if (!new_order_book->accepts(new_order->price)) {
+    new_order->is_cancelled = true;
+    return;
+  }
+  if (sweep<order_type, true>(new_order, new_order->price) != 0) {
+    new_order_book->push(new_order);
+  }
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+template <LimitOrder::OrderType order_type>
+bool BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::can_fill(
+    const LimitOrder *new_order) const {
+  const volume_t needed{new_order->quantity - new_order->filled_quantity};
+  volume_t available{0};
+  auto add_level = [&](const PriceLevel &level) {
+    if constexpr (order_type == LimitOrder::OrderType::Bid) {
+      if (level.price > new_order->price) {
+        return false;
+      }
+    } else {
+      if (level.price < new_order->price) {
+        return false;
+      }
+    }
+    available += level.total_quantity;
+    return available < needed;
+  };
+  if constexpr (order_type == LimitOrder::OrderType::Bid) {
+    asks.for_each_level(add_level);
+  } else {
+    bids.for_each_level(add_level);
+  }
+  return available >= needed;
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+template <LimitOrder::OrderType order_type,
+          LimitOrder::TimeInForce time_in_force>
+void BasicOrderBook<LevelStore, MatchingPolicy,
+                    Allocator>::match_immediate_order(LimitOrder *new_order) {
+  if (new_order->is_cancelled) {
+    return;
+  }
+  if constexpr (time_in_force == LimitOrder::TimeInForce::Fok) {
+    if (!can_fill<order_type>(new_order)) {
+      new_order->is_cancelled = true;
+      return;
+    }
+  }
+  new_order->is_cancelled =
+      sweep<order_type, true>(new_order, new_order->price) != 0;
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+template <LimitOrder::OrderType order_type>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::match_market_order(
+    LimitOrder *new_order, const price_t *band) {
+  if (new_order->is_cancelled) {
+    return;
+  }
+  quantity_t open{0};
+  if (band == nullptr) {
+    open = sweep<order_type, false>(new_order, 0);
+  } else {
+    const PriceLevel *touch = order_type == LimitOrder::OrderType::Bid
+                                  ? asks.best_level()
+                                  : bids.best_level();
+    if (touch != nullptr) {
+      // Saturate the band at the ends of the price range.
+      constexpr price_t max_price{std::numeric_limits<price_t>::max()};
+      if constexpr (order_type == LimitOrder::OrderType::Bid) {
+        new_order->price = touch->price > max_price - *band
+                               ? max_price
+                               : touch->price + *band;
+      } else {
+        new_order->price = touch->price < *band ? 0 : touch->price - *band;
+      }
+      open = sweep<order_type, true>(new_order, new_order->price);
+    } else {
+      open = new_order->quantity - new_order->filled_quantity;
+    }
+  }
+  new_order->is_cancelled = open != 0;
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+template <LimitOrder::OrderType order_type>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::post_order(
+    LimitOrder *new_order, const LimitOrder::PostOnly post_only) {
+  using new_order_book_t =
+      std::conditional_t<order_type == LimitOrder::OrderType::Bid,
+                         decltype(bids), decltype(asks)>;
+  new_order_book_t *new_order_book;
+  const PriceLevel *touch;
+  if constexpr (order_type == LimitOrder::OrderType::Bid) {
+    new_order_book = &bids;
+    touch = asks.best_level();
+  } else {
+    new_order_book = &asks;
+    touch = bids.best_level();
+  }
+
+  if (new_order->is_cancelled) {
+    return;
+  }
+  if (touch != nullptr) {
+    const bool crosses = order_type == LimitOrder::OrderType::Bid
+                             ? new_order->price >= touch->price
+                             : new_order->price <= touch->price;
+    if (crosses) {
+      if (post_only == LimitOrder::PostOnly::Reject) {
+        new_order->is_cancelled = true;
+        return;
+      }
+      // There is no price one tick past the ends of the price range.
+      constexpr price_t max_price{std::numeric_limits<price_t>::max()};
+      if constexpr (order_type == LimitOrder::OrderType::Bid) {
+        if (touch->price < tick_size) {
+          new_order->is_cancelled = true;
+          return;
+        }
+        new_order->price = touch->price - tick_size;
+      } else {
+        if (touch->price > max_price - tick_size) {
+          new_order->is_cancelled = true;
+          return;
+        }
+        new_order->price = touch->price + tick_size;
+      }
+    }
+  }
+  if (!new_order_book->accepts(new_order->price)) {
+    new_order->is_cancelled = true;
+    return;
+  }
+  new_order_book->push(new_order);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+template <LimitOrder::OrderType order_type>
+bool BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::remove_order(
+    LimitOrder *order) {
+  if (order->level == nullptr) {
+    return false;
+  }
+  if constexpr (order_type == LimitOrder::OrderType::Bid) {
+    bids.erase(order);
+  } else {
+    asks.erase(order);
+  }
+  order->is_cancelled = true;
+  return true;
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+template <LimitOrder::OrderType order_type>
+bool BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::amend_order(
+    LimitOrder *order, const price_t price, const quantity_t quantity,
+    const sequence_t sequence) {
+  if (order->level == nullptr) {
+    return false;
+  }
+  if (quantity <= order->filled_quantity) {
+    return remove_order<order_type>(order);
+  }
+  if (price == order->price && quantity <= order->quantity) {
+    order->level->reduce(order, order->quantity - quantity);
+    return true;
+  }
+  if constexpr (order_type == LimitOrder::OrderType::Bid) {
+    if (!bids.accepts(price)) {
+      return false;
+    }
+    bids.erase(order);
+  } else {
+    if (!asks.accepts(price)) {
+      return false;
+    }
+    asks.erase(order);
+  }
+  order->price = price;
+  order->quantity = quantity;
+  order->sequence = sequence;
+  match_orders<order_type>(order);
+  return true;
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::add_bid_order(
+    LimitOrder *order) {
+  match_orders<LimitOrder::OrderType::Bid>(order);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::add_ask_order(
+    LimitOrder *order) {
+  match_orders<LimitOrder::OrderType::Ask>(order);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::add_ioc_bid_order(
+    LimitOrder *order) {
+  match_immediate_order<LimitOrder::OrderType::Bid,
+                        LimitOrder::TimeInForce::Ioc>(order);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::add_ioc_ask_order(
+    LimitOrder *order) {
+  match_immediate_order<LimitOrder::OrderType::Ask,
+                        LimitOrder::TimeInForce::Ioc>(order);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::add_fok_bid_order(
+    LimitOrder *order) {
+  match_immediate_order<LimitOrder::OrderType::Bid,
+                        LimitOrder::TimeInForce::Fok>(order);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::add_fok_ask_order(
+    LimitOrder *order) {
+  match_immediate_order<LimitOrder::OrderType::Ask,
+                        LimitOrder::TimeInForce::Fok>(order);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy,
+                    Allocator>::add_market_bid_order(LimitOrder *order) {
+  match_market_order<LimitOrder::OrderType::Bid>(order, nullptr);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::
+    add_market_bid_order(LimitOrder *order, const price_t band) {
+  match_market_order<LimitOrder::OrderType::Bid>(order, &band);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy,
+                    Allocator>::add_market_ask_order(LimitOrder *order) {
+  match_market_order<LimitOrder::OrderType::Ask>(order, nullptr);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::
+    add_market_ask_order(LimitOrder *order, const price_t band) {
+  match_market_order<LimitOrder::OrderType::Ask>(order, &band);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy,
+                    Allocator>::add_post_only_bid_order(
+    LimitOrder *order, const LimitOrder::PostOnly post_only) {
+  post_order<LimitOrder::OrderType::Bid>(order, post_only);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+void BasicOrderBook<LevelStore, MatchingPolicy,
+                    Allocator>::add_post_only_ask_order(
+    LimitOrder *order, const LimitOrder::PostOnly post_only) {
+  post_order<LimitOrder::OrderType::Ask>(order, post_only);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+bool BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::cancel_bid_order(
+    LimitOrder *order) {
+  return remove_order<LimitOrder::OrderType::Bid>(order);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+bool BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::cancel_ask_order(
+    LimitOrder *order) {
+  return remove_order<LimitOrder::OrderType::Ask>(order);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+bool BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::modify_bid_order(
+    LimitOrder *order, const price_t price, const quantity_t quantity,
+    const sequence_t sequence) {
+  return amend_order<LimitOrder::OrderType::Bid>(order, price, quantity,
+                                                 sequence);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+bool BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::modify_ask_order(
+    LimitOrder *order, const price_t price, const quantity_t quantity,
+    const sequence_t sequence) {
+  return amend_order<LimitOrder::OrderType::Ask>(order, price, quantity,
+                                                 sequence);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+const PriceLevel *
+BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::get_best_bid_level()
+    const {
+  return bids.best_level();
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+const PriceLevel *
+BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::get_best_ask_level()
+    const {
+  return asks.best_level();
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+std::size_t
+BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::get_bid_depth(
+    std::span<DepthLevel> depth) const {
+  return detail::collect_depth(bids, depth);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+std::size_t
+BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::get_ask_depth(
+    std::span<DepthLevel> depth) const {
+  return detail::collect_depth(asks, depth);
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+const LimitOrder *
+BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::get_best_bid_order()
+    const {
+  const PriceLevel *level = bids.best_level();
+  return level == nullptr ? nullptr : level->front();
+}
+
+template <template <LimitOrder::OrderType, typename> class LevelStore,
+          typename MatchingPolicy, typename Allocator>
+const LimitOrder *
+BasicOrderBook<LevelStore, MatchingPolicy, Allocator>::get_best_ask_order()
+    const {
+  const PriceLevel *level = asks.best_level();
+  return level == nullptr ? nullptr : level->front();
+}
+
+} // namespace clob
\ No newline at end of file
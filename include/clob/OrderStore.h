@@ -0,0 +1,403 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "clob/LimitOrder.h"
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief Append-only store of a market's orders, addressed by 32-bit handles.
+ *
+ * @details Order records live in cache-line aligned chunks of chunk_size
+ * records, so a handle resolves with a shift, a mask and one load from a
+ * small chunk table instead of a load through a per-order pointer, and
+ * records never move once created. Per-order routing, the stock and side,
+ * whether the order still rests in its book, and the cold wall-clock
+ * timestamp are kept in separate contiguous columns inside each chunk so that
+ * scans over a stock's live orders stream through five bytes per order
+ * without touching the records. Each chunk also counts its live orders and
+ * keeps the latest time one of them became terminal, so whether a whole
+ * chunk can be released is known without visiting its orders. Whole chunks
+ * can be released once their orders are no longer needed; their handles stay
+ * allocated but no longer resolve.
+ *
+ * An order id is its handle in the low 32 bits and the generation of its slot
+ * above them. Slots start at generation 0, so ids equal handles unless slots
+ * are reused, and an id outlived by its slot no longer matches the id stored
+ * in the record.
+ */
+class OrderStore {
+public:
+  using handle_t = std::uint32_t;
+  static constexpr unsigned generation_shift{32};
+  static constexpr std::size_t chunk_bits{12};
+  static constexpr std::size_t chunk_size{std::size_t{1} << chunk_bits};
+
+private:
+  struct Chunk {
+    alignas(LimitOrder) std::byte storage[sizeof(LimitOrder) * chunk_size];
+    timestamp_ns_t timestamps[chunk_size];
+    std::uint32_t stock_ids[chunk_size];
+    LimitOrder::OrderType order_types[chunk_size];
+    bool live[chunk_size];
+    std::size_t num_live;
+    timestamp_ns_t last_terminal;
+  };
+
+  struct ChunkDeleter {
+    std::pmr::memory_resource *resource;
+
+    void operator()(Chunk *chunk) const {
+      resource->deallocate(chunk, sizeof(Chunk), alignof(Chunk));
+    }
+  };
+
+  using chunk_ptr_t = std::unique_ptr<Chunk, ChunkDeleter>;
+
+  std::pmr::memory_resource *resource;
+  std::pmr::vector<chunk_ptr_t> chunks;
+  std::pmr::vector<chunk_ptr_t> spare_chunks;
+  std::size_t num_orders{0};
+  std::size_t num_resident{0};
+
+  static constexpr std::size_t slot_of(const handle_t handle) {
+    return handle & (chunk_size - 1);
+  }
+
+  Chunk &chunk_of(const handle_t handle) const {
+    return *chunks[handle >> chunk_bits];
+  }
+
+  chunk_ptr_t allocate_chunk() const {
+    return chunk_ptr_t(
+        ::new (resource->allocate(sizeof(Chunk), alignof(Chunk))) Chunk,
+        ChunkDeleter{resource});
+  }
+
+  LimitOrder *record(const handle_t handle) const {
+    return std::launder(
+               reinterpret_cast<LimitOrder *>(chunk_of(handle).storage)) +
+           slot_of(handle);
+  }
+
+public:
+  /**
+   * @brief Construct an empty store.
+   *
+   * @param resource The memory resource for the chunks and chunk tables, it
+   * must outlive the store.
+   */
+  explicit OrderStore(
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : resource(resource), chunks(resource), spare_chunks(resource) {}
+  OrderStore(const OrderStore &) = delete;
+  OrderStore &operator=(const OrderStore &) = delete;
+
+  /**
+   * @brief Append an order, its handle is the number of orders before it.
+   *
+   * @param stock_id The stock the order is routed to.
+   * @param order_type The side of the order.
+   * @param timestamp The timestamp of the order.
+   * @param sequence The sequence number of the order.
+   * @param price The price of the order.
+   * @param quantity The quantity of the order.
+   * @return The new order, with its id set to its handle, marked live.
+   */
+  LimitOrder *create(const std::uint32_t stock_id,
+                     const LimitOrder::OrderType order_type,
+                     const timestamp_ns_t timestamp, const sequence_t sequence,
+                     const price_t price, const quantity_t quantity) {
+    const auto handle = static_cast<handle_t>(num_orders);
+    if (slot_of(handle) == 0) {
+      if (spare_chunks.empty()) {
+        chunks.push_back(allocate_chunk());
+      } else {
+        chunks.push_back(std::move(spare_chunks.back()));
+        spare_chunks.pop_back();
+      }
+      chunks.back()->num_live = 0;
+      chunks.back()->last_terminal = 0;
+      ++num_resident;
+    }
+    ++num_orders;
+    Chunk &chunk = chunk_of(handle);
+    ++chunk.num_live;
+    chunk.timestamps[slot_of(handle)] = timestamp;
+    chunk.stock_ids[slot_of(handle)] = stock_id;
+    chunk.order_types[slot_of(handle)] = order_type;
+    chunk.live[slot_of(handle)] = true;
+    return ::new (static_cast<void *>(record(handle)))
+        LimitOrder(handle, sequence, price, quantity);
+  }
+
+  /**
+   * @brief Allocate and touch the chunks for at least capacity orders, so
+   * that adding them allocates nothing and takes no page faults.
+   *
+   * @param capacity The number of orders to hold without allocating.
+   */
+  void reserve(const std::size_t capacity) {
+    const std::size_t num_chunks = (capacity + chunk_size - 1) / chunk_size;
+    chunks.reserve(num_chunks);
+    while (chunks.size() + spare_chunks.size() < num_chunks) {
+      chunk_ptr_t chunk = allocate_chunk();
+      std::memset(static_cast<void *>(chunk.get()), 0, sizeof(Chunk));
+      spare_chunks.push_back(std::move(chunk));
+    }
+  }
+
+  /**
+   * @brief Replace the order in a slot with a new one of the next generation.
+   * Assumes the slot is resident and its order rests in no book.
+   *
+   * @param handle The slot to reuse.
+   * @param stock_id The stock the order is routed to.
+   * @param order_type The side of the order.
+   * @param timestamp The timestamp of the order.
+   * @param sequence The sequence number of the order.
+   * @param price The price of the order.
+   * @param quantity The quantity of the order.
+   * @return The new order, marked live.
+   */
+  LimitOrder *reuse(const handle_t handle, const std::uint32_t stock_id,
+                    const LimitOrder::OrderType order_type,
+                    const timestamp_ns_t timestamp, const sequence_t sequence,
+                    const price_t price, const quantity_t quantity) {
+    LimitOrder *order = record(handle);
+    const LimitOrder::id_t id =
+        order->id + (LimitOrder::id_t{1} << generation_shift);
+    Chunk &chunk = chunk_of(handle);
+    chunk.num_live += !chunk.live[slot_of(handle)];
+    chunk.timestamps[slot_of(handle)] = timestamp;
+    chunk.stock_ids[slot_of(handle)] = stock_id;
+    chunk.order_types[slot_of(handle)] = order_type;
+    chunk.live[slot_of(handle)] = true;
+    return ::new (static_cast<void *>(order))
+        LimitOrder(id, sequence, price, quantity);
+  }
+
+  /**
+   * @brief Get the slot an order id refers to.
+   *
+   * @param id The id of the order.
+   * @return The handle of its slot.
+   */
+  static constexpr handle_t handle_of(const LimitOrder::id_t id) {
+    return static_cast<handle_t>(id);
+  }
+
+  /**
+   * @brief Check whether an order's chunk is still held in memory.
+   * Assumes the handle is below size().
+   *
+   * @param handle The handle of the order.
+   * @return True if the order can be looked up.
+   */
+  bool is_resident(const handle_t handle) const {
+    return chunks[handle >> chunk_bits] != nullptr;
+  }
+
+  /**
+   * @brief Get an order.
+   * Assumes the order is resident.
+   *
+   * @param handle The handle of the order.
+   * @return The order.
+   */
+  LimitOrder *get(const handle_t handle) { return record(handle); }
+
+  /**
+   * @brief Get an order.
+   * Assumes the order is resident.
+   *
+   * @param handle The handle of the order.
+   * @return The order.
+   */
+  const LimitOrder *get(const handle_t handle) const { return record(handle); }
+
+  /**
+   * @brief Get the time an order was accepted or last re-queued.
+   * Assumes the order is resident.
+   *
+   * @param handle The handle of the order.
+   * @return The timestamp.
+   */
+  timestamp_ns_t timestamp(const handle_t handle) const {
+    return chunk_of(handle).timestamps[slot_of(handle)];
+  }
+
+  /**
+   * @brief Set the time an order was last re-queued.
+   * Assumes the order is resident.
+   *
+   * @param handle The handle of the order.
+   * @param timestamp The timestamp.
+   */
+  void set_timestamp(const handle_t handle, const timestamp_ns_t timestamp) {
+    chunk_of(handle).timestamps[slot_of(handle)] = timestamp;
+  }
+
+  /**
+   * @brief Get the stock an order is routed to.
+   * Assumes the order is resident.
+   *
+   * @param handle The handle of the order.
+   * @return The stock id.
+   */
+  std::uint32_t stock_id(const handle_t handle) const {
+    return chunk_of(handle).stock_ids[slot_of(handle)];
+  }
+
+  /**
+   * @brief Get the side of an order.
+   * Assumes the order is resident.
+   *
+   * @param handle The handle of the order.
+   * @return The order type.
+   */
+  LimitOrder::OrderType order_type(const handle_t handle) const {
+    return chunk_of(handle).order_types[slot_of(handle)];
+  }
+
+  /**
+   * @brief Check whether an order still rests in its book.
+   * Assumes the order is resident.
+   *
+   * @param handle The handle of the order.
+   * @return True until the order is marked terminal.
+   */
+  bool is_live(const handle_t handle) const {
+    return chunk_of(handle).live[slot_of(handle)];
+  }
+
+  /**
+   * @brief Mark an order filled or cancelled, it no longer rests in a book.
+   * Assumes the order is resident. Marking a terminal order again does
+   * nothing.
+   *
+   * @param handle The handle of the order.
+   * @param timestamp The time the order became terminal.
+   */
+  void set_terminal(const handle_t handle, const timestamp_ns_t timestamp) {
+    Chunk &chunk = chunk_of(handle);
+    if (chunk.live[slot_of(handle)]) {
+      chunk.live[slot_of(handle)] = false;
+      --chunk.num_live;
+      chunk.last_terminal = std::max(chunk.last_terminal, timestamp);
+    }
+  }
+
+  /**
+   * @brief Get the number of live orders in a chunk.
+   * Assumes the chunk is resident.
+   *
+   * @param chunk The index of the chunk.
+   * @return The number of orders not yet marked terminal.
+   */
+  std::size_t num_live(const std::size_t chunk) const {
+    return chunks[chunk]->num_live;
+  }
+
+  /**
+   * @brief Get the latest time an order of a chunk became terminal.
+   * Assumes the chunk is resident.
+   *
+   * @param chunk The index of the chunk.
+   * @return The latest timestamp passed to set_terminal, 0 if none.
+   */
+  timestamp_ns_t last_terminal(const std::size_t chunk) const {
+    return chunks[chunk]->last_terminal;
+  }
+
+  /**
+   * @brief Free a chunk and every order in it.
+   * Assumes no order in the chunk rests in a book.
+   *
+   * @param chunk The index of the chunk, the handle of its first order
+   * shifted right by chunk_bits.
+   */
+  void release_chunk(const std::size_t chunk) {
+    if (chunks[chunk] != nullptr) {
+      chunks[chunk].reset();
+      --num_resident;
+    }
+  }
+
+  /**
+   * @brief Visit every live resident order routed to a stock.
+   *
+   * @details Only the stock and live columns are read, five bytes per order;
+   * records are touched for matching orders alone. fn may mark the order it
+   * is given terminal.
+   *
+   * @param stock_id The stock to scan for.
+   * @param fn Callable taking the handle_t of each matching order, in order.
+   */
+  template <typename Fn>
+  void for_each_live_order(const std::uint32_t stock_id, Fn &&fn) const {
+    for (std::size_t c = 0; c < chunks.size(); ++c) {
+      if (chunks[c] == nullptr) {
+        continue;
+      }
+      const std::uint32_t *stock_ids = chunks[c]->stock_ids;
+      const bool *live = chunks[c]->live;
+      const std::size_t first = c << chunk_bits;
+      const std::size_t n = std::min(chunk_size, num_orders - first);
+      for (std::size_t i = 0; i < n; ++i) {
+        if (stock_ids[i] == stock_id && live[i]) {
+          fn(static_cast<handle_t>(first + i));
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of orders in the store.
+   *
+   * @return The number of orders.
+   */
+  std::size_t size() const { return num_orders; }
+
+  /**
+   * @brief Get the number of chunks the store has allocated, released ones
+   * included.
+   *
+   * @return The number of chunks.
+   */
+  std::size_t num_chunks() const { return chunks.size(); }
+
+  /**
+   * @brief Get the number of chunks held in memory.
+   *
+   * @return The number of resident chunks.
+   */
+  std::size_t num_resident_chunks() const { return num_resident; }
+
+  /**
+   * @brief Get the largest number of orders the store can address.
+   *
+   * @return The number of distinct handles.
+   */
+  static constexpr std::size_t max_size() {
+    return std::size_t{UINT32_MAX} + 1;
+  }
+};
+
+} // namespace clob
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "clob/LimitOrder.h"
+#include "clob/PriceLevel.h"
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief PriceLadder needs no configuration, every price is accepted.
+ */
+struct PriceLadderConfig {};
+
+/**
+ * @brief One side of the order book, kept as a ladder of price levels.
+ *
+ * @details Each distinct price owns a PriceLevel holding its orders in FIFO
+ * order. Levels are sorted best first, so the best level is always at the
+ * front of the ladder.
+ */
+template <LimitOrder::OrderType order_type,
+          typename Allocator = std::allocator<PriceLevel>>
+class PriceLadder {
+public:
+  using config_t = PriceLadderConfig;
+
+private:
+  using compare_t = std::conditional_t<order_type == LimitOrder::OrderType::Bid,
+                                       std::greater<price_t>,
+                                       std::less<price_t>>;
+  using node_allocator_t = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<std::pair<const price_t, PriceLevel>>;
+
+  std::map<price_t, PriceLevel, compare_t, node_allocator_t> levels;
+  std::size_t num_orders{0};
+
+public:
+  explicit PriceLadder(const config_t & = {},
+                       const Allocator &allocator = Allocator())
+      : levels(node_allocator_t(allocator)) {}
+
+  /**
+   * @brief Check whether the ladder can hold a price.
+   *
+   * @return Always true.
+   */
+  constexpr bool accepts(const price_t) const { return true; }
+
+  /**
+   * @brief Get the level with the best price.
+   *
+   * @return The best level, nullptr if the ladder is empty.
+   */
+  PriceLevel *best_level() {
+    return levels.empty() ? nullptr : &levels.begin()->second;
+  }
+
+  /**
+   * @brief Get the level with the best price.
+   *
+   * @return The best level, nullptr if the ladder is empty.
+   */
+  const PriceLevel *best_level() const {
+    return levels.empty() ? nullptr : &levels.begin()->second;
+  }
+
+  /**
+   * @brief Append an order to the level at its price, creating the level if
+   * needed.
+   *
+   * @param order The order to add.
+   */
+  void push(LimitOrder *order) {
+    PriceLevel *level;
+    if (!levels.empty() && levels.begin()->first == order->price) {
+      level = &levels.begin()->second;
+    } else {
+      level = &levels.try_emplace(order->price, order->price).first->second;
+    }
+    level->push_back(order);
+    ++num_orders;
+  }
+
+  /**
+   * @brief Remove the front order of the best level, releasing the level once
+   * it is empty.
+   * Assumes the ladder is not empty.
+   */
+  void pop() {
+    auto it = levels.begin();
+    it->second.pop_front();
+    --num_orders;
+    if (it->second.empty()) {
+      levels.erase(it);
+    }
+  }
+
+  /**
+   * @brief Remove the best level and every order on it in one step.
+   * Assumes the ladder is not empty.
+   *
+   * @param fn Callable taking a LimitOrder *, called on each order in FIFO
+   * order once it has been unlinked.
+   */
+  template <typename Fn> void pop_level(Fn &&fn) {
+    auto it = levels.begin();
+    num_orders -= it->second.order_count;
+    it->second.drain(fn);
+    levels.erase(it);
+  }
+
+  /**
+   * @brief Unlink a resting order, releasing its level once it is empty.
+   * Assumes the order rests in this ladder.
+   *
+   * @param order The order to remove.
+   */
+  void erase(LimitOrder *order) {
+    PriceLevel *level = order->level;
+    level->erase(order);
+    --num_orders;
+    if (level->empty()) {
+      auto it = levels.begin();
+      if (&it->second == level) {
+        levels.erase(it);
+      } else {
+        levels.erase(level->price);
+      }
+    }
+  }
+
+  /**
+   * @brief Visit levels from best to worst until fn returns false.
+   *
+   * @param fn Callable taking a const PriceLevel & and returning bool.
+   */
+  template <typename Fn> void for_each_level(Fn &&fn) const {
+    for (const auto &[price, level] : levels) {
+      if (!fn(level)) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of orders in the ladder.
+   *
+   * @return The number of orders.
+   */
+  std::size_t size() const { return num_orders; }
+
+  /**
+   * @brief Get the number of price levels in the ladder.
+   *
+   * @return The number of levels.
+   */
+  std::size_t num_levels() const { return levels.size(); }
+
+  /**
+   * @brief Check whether the ladder holds no orders.
+   *
+   * @return True if the ladder is empty.
+   */
+  bool empty() const { return num_orders == 0; }
+};
+
+} // namespace clob
\ No newline at end of file
@@ -0,0 +1,155 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "clob/LimitOrder.h"
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief A single price level of the order book.
+ *
+ * @details Holds an intrusive FIFO of the orders resting at one price, linked
+ * through LimitOrder::prev and LimitOrder::next. Orders are kept in time
+ * priority by appending them in O(1): sequence numbers only grow, so the
+ * newest order always belongs at the tail and no priority key is compared.
+ * Any order can be unlinked in O(1). The level keeps a running total of its
+ * open quantity and order count.
+ */
+class PriceLevel {
+public:
+  price_t price;
+  LimitOrder *head;
+  LimitOrder *tail;
+  volume_t total_quantity;
+  std::size_t order_count;
+
+  PriceLevel() : PriceLevel(0) {}
+
+  explicit PriceLevel(const price_t price)
+      : price(price), head(nullptr), tail(nullptr), total_quantity(0),
+        order_count(0) {}
+
+  PriceLevel(const PriceLevel &) = delete;
+  PriceLevel &operator=(const PriceLevel &) = delete;
+
+  /**
+   * @brief Check whether the level holds no orders.
+   *
+   * @return True if the level is empty.
+   */
+  bool empty() const { return head == nullptr; }
+
+  /**
+   * @brief Get the order with the highest time priority.
+   *
+   * @return The front order, nullptr if the level is empty.
+   */
+  LimitOrder *front() const { return head; }
+
+  /**
+   * @brief Append an order, giving it the lowest time priority.
+   * Assumes its sequence number is above those of the orders at the level.
+   *
+   * @param order The order to append.
+   */
+  void push_back(LimitOrder *order) {
+    order->level = this;
+    total_quantity += order->quantity - order->filled_quantity;
+    ++order_count;
+    order->prev = tail;
+    order->next = nullptr;
+    if (tail == nullptr) {
+      head = order;
+    } else {
+      tail->next = order;
+    }
+    tail = order;
+  }
+
+  /**
+   * @brief Fill part of a resting order's open quantity.
+   * Assumes the order rests on this level and quantity does not exceed its
+   * open quantity.
+   *
+   * @param order The order to fill.
+   * @param quantity The quantity filled.
+   */
+  void fill(LimitOrder *order, const quantity_t quantity) {
+    order->filled_quantity += quantity;
+    total_quantity -= quantity;
+  }
+
+  /**
+   * @brief Reduce the total quantity of a resting order in place.
+   * Assumes the order rests on this level and keeps some open quantity.
+   *
+   * @param order The order to reduce.
+   * @param quantity The quantity removed.
+   */
+  void reduce(LimitOrder *order, const quantity_t quantity) {
+    order->quantity -= quantity;
+    total_quantity -= quantity;
+  }
+
+  /**
+   * @brief Remove the front order.
+   * Assumes the level is not empty.
+   */
+  void pop_front() { erase(head); }
+
+  /**
+   * @brief Unlink every order in FIFO order and empty the level.
+   *
+   * @param fn Callable taking a LimitOrder *, called on each order once it has
+   * been unlinked.
+   */
+  template <typename Fn> void drain(Fn &&fn) {
+    LimitOrder *order = head;
+    while (order != nullptr) {
+      LimitOrder *next = order->next;
+      order->prev = nullptr;
+      order->next = nullptr;
+      order->level = nullptr;
+      fn(order);
+      order = next;
+    }
+    head = nullptr;
+    tail = nullptr;
+    total_quantity = 0;
+    order_count = 0;
+  }
+
+  /**
+   * @brief Unlink an order from the level in O(1).
+   * Assumes the order rests on this level.
+   *
+   * @param order The order to remove.
+   */
+  void erase(LimitOrder *order) {
+    total_quantity -= order->quantity - order->filled_quantity;
+    --order_count;
+    if (order->prev == nullptr) {
+      head = order->next;
+    } else {
+      order->prev->next = order->next;
+    }
+    if (order->next == nullptr) {
+      tail = order->prev;
+    } else {
+      order->next->prev = order->prev;
+    }
+    order->prev = nullptr;
+    order->next = nullptr;
+    order->level = nullptr;
+  }
+};
+
+} // namespace clob
\ No newline at end of file
@@ -0,0 +1,207 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "clob/LimitOrder.h"
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief Scratch state shared by the pro-rata matching policies.
+ *
+ * @details A level is first gathered into flat arrays of orders and open
+ * quantities. Allocations are then computed on the arrays only, the pro-rata
+ * share of every order in one branch free pass, and handed out in a last
+ * pass, so the level is never touched once fills start. Quantities are kept in
+ * 32 bits, the range quantity_t guarantees, and shares are computed with a
+ * 32-bit fixed point ratio so the pass vectorizes without wide multiplies or
+ * divisions.
+ */
+class ProRataAllocator {
+  std::vector<LimitOrder *> orders;
+  std::vector<std::uint32_t> open;
+  std::vector<std::uint32_t> allocation;
+  volume_t total_open{0};
+
+public:
+  static constexpr std::size_t all_orders = static_cast<std::size_t>(-1);
+
+  /**
+   * @brief Gather the orders of a level in FIFO order.
+   *
+   * @param level The level to gather.
+   */
+  template <typename Level> void gather(const Level &level) {
+    orders.clear();
+    open.clear();
+    total_open = 0;
+    for (LimitOrder *order = level.front(); order != nullptr;
+         order = order->next) {
+      const quantity_t order_q = order->quantity - order->filled_quantity;
+      orders.push_back(order);
+      open.push_back(static_cast<std::uint32_t>(order_q));
+      total_open += order_q;
+    }
+    allocation.assign(orders.size(), 0);
+  }
+
+  /**
+   * @brief Allocate to orders in FIFO order.
+   *
+   * @param quantity The quantity to allocate.
+   * @param max_orders The number of orders that may receive an allocation.
+   * @return The quantity allocated.
+   */
+  quantity_t allocate_fifo(const quantity_t quantity,
+                           std::size_t max_orders = all_orders) {
+    quantity_t remaining{quantity};
+    for (std::size_t i = 0;
+         i < open.size() && remaining != 0 && max_orders != 0; ++i) {
+      if (open[i] == 0) {
+        continue;
+      }
+      const auto share = static_cast<std::uint32_t>(
+          open[i] < remaining ? open[i] : remaining);
+      allocation[i] += share;
+      open[i] -= share;
+      remaining -= share;
+      --max_orders;
+    }
+    total_open -= quantity - remaining;
+    return quantity - remaining;
+  }
+
+  /**
+   * @brief Allocate to every order in proportion to its open quantity,
+   * rounding down and dropping shares below min_allocation.
+   *
+   * @param quantity The quantity to allocate.
+   * @param min_allocation The smallest share handed out.
+   * @return The quantity allocated, the rounding remainder is left over.
+   */
+  quantity_t allocate_pro_rata(const quantity_t quantity,
+                               const quantity_t min_allocation) {
+    const std::size_t n = open.size();
+    if (total_open <= quantity) {
+      for (std::size_t i = 0; i < n; ++i) {
+        allocation[i] += open[i];
+        open[i] = 0;
+      }
+      const auto allocated = static_cast<quantity_t>(total_open);
+      total_open = 0;
+      return allocated;
+    }
+
+    // The ratio is rounded up so that exact shares come out exact, which may
+    // overshoot by a unit or so; that is given back from the back of the
+    // queue.
+    const volume_t wide_ratio =
+        ((static_cast<volume_t>(quantity) << 32) + total_open - 1) / total_open;
+    const auto ratio = static_cast<std::uint32_t>(
+        wide_ratio > UINT32_MAX ? UINT32_MAX : wide_ratio);
+    const auto min_share = static_cast<std::uint32_t>(min_allocation);
+    std::uint32_t *const open_data = open.data();
+    std::uint32_t *const allocation_data = allocation.data();
+    volume_t allocated{0};
+    for (std::size_t i = 0; i < n; ++i) {
+      std::uint32_t share = static_cast<std::uint32_t>(
+          (static_cast<std::uint64_t>(open_data[i]) * ratio) >> 32);
+      share = share < min_share ? 0 : share;
+      allocation_data[i] += share;
+      open_data[i] -= share;
+      allocated += share;
+    }
+    for (std::size_t i = n; allocated > quantity && i-- > 0;) {
+      const volume_t excess = allocated - quantity;
+      const std::uint32_t share = allocation_data[i] < excess
+                                      ? allocation_data[i]
+                                      : static_cast<std::uint32_t>(excess);
+      allocation_data[i] -= share;
+      open_data[i] += share;
+      allocated -= share;
+    }
+    total_open -= allocated;
+    return static_cast<quantity_t>(allocated);
+  }
+
+  /**
+   * @brief Hand out the allocations in FIFO order.
+   *
+   * @param fill Callable taking the order and its allocation.
+   */
+  template <typename Fill> void fill(Fill &&fill) {
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+      if (allocation[i] != 0) {
+        fill(orders[i], allocation[i]);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Pro-rata priority: orders at a level share an incoming order in
+ * proportion to their open quantity.
+ *
+ * @details With top_order_priority, the first order of the level is
+ * filled in full before the rest is shared out. Pro-rata shares are rounded
+ * down and shares below min_allocation are dropped; the remainder is then
+ * allocated in FIFO order.
+ */
+template <bool top_order_priority = true, quantity_t min_allocation = 1>
+class ProRataPriority {
+  ProRataAllocator allocator;
+
+public:
+  template <typename Level, typename Fill>
+  quantity_t match(Level &level, const quantity_t quantity, Fill &&fill) {
+    allocator.gather(level);
+    quantity_t allocated{0};
+    if constexpr (top_order_priority) {
+      allocated += allocator.allocate_fifo(quantity, 1);
+    }
+    allocated += allocator.allocate_pro_rata(quantity - allocated,
+                                             min_allocation);
+    allocated += allocator.allocate_fifo(quantity - allocated);
+    allocator.fill(fill);
+    return allocated;
+  }
+};
+
+/**
+ * @brief Split priority: a fixed share of an incoming order is allocated in
+ * FIFO order and the rest pro-rata.
+ *
+ * @details fifo_percent of the incoming quantity, rounded down, is allocated
+ * in FIFO order first. The rest is shared out as in ProRataPriority without
+ * top order priority.
+ */
+template <unsigned fifo_percent = 40, quantity_t min_allocation = 1>
+class FifoProRataPriority {
+  static_assert(fifo_percent <= 100, "fifo_percent must not exceed 100");
+
+  ProRataAllocator allocator;
+
+public:
+  template <typename Level, typename Fill>
+  quantity_t match(Level &level, const quantity_t quantity, Fill &&fill) {
+    allocator.gather(level);
+    quantity_t allocated = allocator.allocate_fifo(static_cast<quantity_t>(
+        static_cast<volume_t>(quantity) * fifo_percent / 100));
+    allocated += allocator.allocate_pro_rata(quantity - allocated,
+                                             min_allocation);
+    allocated += allocator.allocate_fifo(quantity - allocated);
+    allocator.fill(fill);
+    return allocated;
+  }
+};
+
+} // namespace clob
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "clob/types.h"
+
+namespace clob {
+
+/**
+ * @brief One instrument listed in a reference data file.
+ */
+struct ReferenceRecord {
+  std::string_view name;
+  std::string_view ticker;
+  price_t tick_size;
+  quantity_t lot_size;
+};
+
+/**
+ * @brief Read-only view of a reference data file listing the instruments of
+ * a venue.
+ *
+ * @details The file is memory mapped, or read whole where it cannot be, and
+ * records are parsed in place: their names and tickers point into the file
+ * and stay valid while it is open. Two formats are recognised:
+ * - Binary, as written by write(): the magic "CLOBREF1", a uint32 record
+ *   count and a uint32 zero, then one 24 byte record per instrument holding
+ *   the ticker NUL padded to 8 characters, the tick size, the lot size, and
+ *   the offset and size of the name, and last the names, with offsets counted
+ *   from the end of the records. Integers are in native byte order.
+ * - CSV: one "name,ticker,tick_size,lot_size" line per instrument, without
+ *   quoting, after an optional header line starting with "name,". Empty
+ *   lines are skipped.
+ */
+class ReferenceFile {
+  struct BinaryRecord {
+    char ticker[8];
+    std::uint32_t tick_size;
+    std::uint32_t lot_size;
+    std::uint32_t name_offset;
+    std::uint32_t name_size;
+  };
+
+  static constexpr std::string_view magic{"CLOBREF1"};
+  static constexpr std::size_t header_size{16};
+
+  const char *data{nullptr};
+  std::size_t data_size{0};
+  bool mapped{false};
+  std::vector<char> buffer;
+  bool binary{false};
+  std::size_t num_records{0};
+  std::size_t next_record{0};
+  std::size_t cursor{0};
+
+  void close();
+  bool open_binary();
+  void open_csv();
+  bool read_binary(ReferenceRecord &record);
+  bool read_csv(ReferenceRecord &record);
+
+public:
+  ReferenceFile() = default;
+  ReferenceFile(const ReferenceFile &) = delete;
+  ReferenceFile &operator=(const ReferenceFile &) = delete;
+  ~ReferenceFile() { close(); }
+
+  /**
+   * @brief Map a reference data file and detect its format.
+   *
+   * @param path The path of the file.
+   * @return True if the file has been opened, false if it cannot be read or
+   * its binary header is inconsistent with its size.
+   */
+  bool open(const std::string &path);
+
+  /**
+   * @brief Get the number of records in the file.
+   *
+   * @return The number of records, for CSV the number of non-empty lines
+   * after the header.
+   */
+  std::size_t size() const { return num_records; }
+
+  /**
+   * @brief Get the size of the file, a bound on the text of its records.
+   *
+   * @return The size in bytes.
+   */
+  std::size_t size_bytes() const { return data_size; }
+
+  /**
+   * @brief Read the next record.
+   *
+   * @param record Receives the record.
+   * @return True if a record has been read, false at the end of the file or
+   * on a malformed record, see at_end.
+   */
+  bool read(ReferenceRecord &record);
+
+  /**
+   * @brief Check whether every record has been read.
+   *
+   * @return True if there is no record left.
+   */
+  bool at_end() const { return next_record == num_records; }
+
+  /**
+   * @brief Write records to a binary reference data file.
+   *
+   * @param path The file, created or truncated.
+   * @param records The records, tickers of at most 8 characters.
+   * @return True if the file has been written.
+   */
+  static bool write(const std::string &path,
+                    std::span<const ReferenceRecord> records);
+};
+
+} // namespace clob
\ No newline at end of file
@@ -7,42 +7,46 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
-#include <utility>
+#include <string_view>
+
+#include "clob/TickerIndex.h"
+#include "clob/types.h"
 
 namespace clob {
 
 /**
  * @brief A class representing a stock
  *
- * @details Includes the name, ticker, and id of the stock.
+ * @details Includes the name, ticker, id, tick size and lot size of the stock.
+ * The name and ticker are views of strings owned elsewhere, Market copies
+ * them into its StringArena, and the ticker is also kept packed into an
+ * 8-byte code so that comparing tickers never touches the text.
  */
 class Stock {
 public:
   using id_t = uint_fast32_t;
-  const std::string name;
-  const std::string ticker;
+  using code_t = TickerIndex::key_t;
+  const std::string_view name;
+  const std::string_view ticker;
+  const code_t ticker_code;
   const Stock::id_t id;
+  const price_t tick_size;
+  const quantity_t lot_size;
 
   /**
    * @brief Construct a new Stock object
    *
-   * @param name The name of the stock
-   * @param ticker The ticker of the stock
-   * @param id The id of the stock
-   */
-  Stock(const std::string &name, const std::string &ticker, const id_t id)
-      : name(name), ticker(ticker), id(id) {}
-
-  /**
-   * @brief Construct a new Stock object
-   *
-   * @param name The name of the stock
-   * @param ticker The ticker of the stock
+   * @param name The name of the stock, it must outlive the stock
+   * @param ticker The ticker of the stock, it must outlive the stock
    * @param id The id of the stock
+   * @param tick_size The price increment of the stock
+   * @param lot_size The quantity increment of the stock
    */
-  Stock(std::string &&name, std::string &&ticker, const id_t id)
-      : name(std::move(name)), ticker(std::move(ticker)), id(id) {}
+  Stock(const std::string_view name, const std::string_view ticker,
+        const id_t id, const price_t tick_size = 1,
+        const quantity_t lot_size = 1)
+      : name(name), ticker(ticker), ticker_code(TickerIndex::pack(ticker)),
+        id(id), tick_size(tick_size), lot_size(lot_size) {}
 
   Stock(const Stock &) = default;
   Stock(Stock &&) = default;
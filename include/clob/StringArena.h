@@ -0,0 +1,94 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace clob {
+
+/**
+ * @brief Append-only store of strings.
+ *
+ * @details Strings are copied back to back into large blocks, so a symbol
+ * table's text sits in a few contiguous runs instead of one heap allocation
+ * per string. Blocks never move or shrink, so the views handed out stay valid
+ * until the arena is destroyed. Strings are not deduplicated, callers that
+ * need each string once, like Market with its ticker index, check first.
+ */
+class StringArena {
+  struct Block {
+    char *data;
+    std::size_t size;
+  };
+
+  static constexpr std::size_t block_size{65536};
+
+  std::pmr::memory_resource *resource;
+  std::pmr::vector<Block> blocks;
+  char *cursor{nullptr};
+  char *end{nullptr};
+  std::size_t num_strings{0};
+  std::size_t num_bytes{0};
+
+  void add_block(const std::size_t min_size);
+
+public:
+  /**
+   * @brief Construct an empty arena.
+   *
+   * @param resource The memory resource for the blocks, it must outlive the
+   * arena.
+   */
+  explicit StringArena(
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : resource(resource), blocks(resource) {}
+  StringArena(const StringArena &) = delete;
+  StringArena &operator=(const StringArena &) = delete;
+  ~StringArena();
+
+  /**
+   * @brief Store a copy of a string after the previous one.
+   *
+   * @param text The string to store.
+   * @return A view of the stored copy, equal to text.
+   */
+  std::string_view append(const std::string_view text);
+
+  /**
+   * @brief Make room for a number of bytes so that appending strings of that
+   * total size allocates no further block.
+   *
+   * @param bytes The total size of the strings to make room for.
+   */
+  void reserve(const std::size_t bytes);
+
+  /**
+   * @brief Get the number of strings stored.
+   *
+   * @return The number of strings.
+   */
+  std::size_t size() const { return num_strings; }
+
+  /**
+   * @brief Get the number of bytes of text stored.
+   *
+   * @return The bytes stored.
+   */
+  std::size_t size_bytes() const { return num_bytes; }
+
+  /**
+   * @brief Get the number of blocks allocated.
+   *
+   * @return The number of blocks.
+   */
+  std::size_t num_blocks() const { return blocks.size(); }
+};
+
+} // namespace clob
\ No newline at end of file
@@ -0,0 +1,178 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace clob {
+
+/**
+ * @brief Index from tickers packed into 64-bit keys to dense values.
+ *
+ * @details Tickers of up to eight characters are packed into a key, so
+ * resolving one never hashes a string or allocates. Keys are inserted into a
+ * hash map while the universe is built, then freeze() replaces the map with a
+ * minimal perfect hash: keys are split into buckets by their hash, and each
+ * bucket stores a pilot chosen so that its keys land on distinct slots of a
+ * table holding exactly one slot per key. A lookup is two multiplicative
+ * hashes, one pilot load and one slot load.
+ */
+class TickerIndex {
+public:
+  using key_t = std::uint64_t;
+  using value_t = std::uint32_t;
+
+private:
+  struct Slot {
+    key_t key;
+    value_t value;
+  };
+
+  std::pmr::memory_resource *resource;
+  std::pmr::unordered_map<key_t, value_t> entries;
+  std::pmr::vector<std::uint64_t> pilots;
+  std::pmr::vector<Slot> slots;
+  bool frozen{false};
+
+  static constexpr std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+  }
+
+  static constexpr std::size_t reduce(const std::uint64_t hash,
+                                      const std::size_t n) {
+    return static_cast<std::size_t>(((hash >> 32) * n) >> 32);
+  }
+
+  static constexpr std::size_t slot_of(const std::uint64_t hash,
+                                       const std::uint64_t pilot,
+                                       const std::size_t num_slots) {
+    return reduce(mix(hash ^ pilot), num_slots);
+  }
+
+public:
+  /**
+   * @brief Construct an empty index.
+   *
+   * @param resource The memory resource for the map and the tables, it must
+   * outlive the index.
+   */
+  explicit TickerIndex(
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : resource(resource), entries(resource), pilots(resource),
+        slots(resource) {}
+
+  /**
+   * @brief Pack a ticker into a key, one byte per character.
+   *
+   * @param ticker The ticker to pack.
+   * @return The key, 0 if the ticker is empty, longer than eight characters
+   * or holds a NUL character.
+   */
+  static constexpr key_t pack(const std::string_view ticker) {
+    if (ticker.empty() || ticker.size() > sizeof(key_t)) {
+      return 0;
+    }
+    key_t key{0};
+    for (std::size_t i = 0; i < ticker.size(); ++i) {
+      if (ticker[i] == '\0') {
+        return 0;
+      }
+      key |= static_cast<key_t>(static_cast<unsigned char>(ticker[i]))
+             << (8 * i);
+    }
+    return key;
+  }
+
+  /**
+   * @brief Add a key.
+   *
+   * @param key The packed ticker.
+   * @param value The value to map it to.
+   * @return True if the key has been added, false if it is 0, already in the
+   * index or the index is frozen.
+   */
+  bool insert(const key_t key, const value_t value) {
+    if (key == 0 || frozen) {
+      return false;
+    }
+    return entries.emplace(key, value).second;
+  }
+
+  /**
+   * @brief Make room for a number of keys before freezing.
+   *
+   * @param num_keys The number of keys to insert without rehashing.
+   */
+  void reserve(const std::size_t num_keys) {
+    if (!frozen) {
+      entries.reserve(num_keys);
+    }
+  }
+
+  /**
+   * @brief Look a key up.
+   *
+   * @param key The packed ticker.
+   * @param value Receives the value of the key.
+   * @return True if the key has been found.
+   */
+  bool find(const key_t key, value_t &value) const {
+    if (!frozen) {
+      const auto it = entries.find(key);
+      if (it == entries.end()) {
+        return false;
+      }
+      value = it->second;
+      return true;
+    }
+    if (slots.empty()) {
+      return false;
+    }
+    const std::uint64_t hash = mix(key);
+    const std::uint64_t pilot = pilots[reduce(hash, pilots.size())];
+    const Slot &slot = slots[slot_of(hash, pilot, slots.size())];
+    if (slot.key != key) {
+      return false;
+    }
+    value = slot.value;
+    return true;
+  }
+
+  /**
+   * @brief Replace the map with a minimal perfect hash, after which no key
+   * can be added.
+   *
+   * @return True if the index is frozen, false if no pilot could be found for
+   * some bucket, in which case the index keeps its map.
+   */
+  bool freeze();
+
+  /**
+   * @brief Check whether the index has been frozen.
+   *
+   * @return True if the index is frozen.
+   */
+  bool is_frozen() const { return frozen; }
+
+  /**
+   * @brief Get the number of keys.
+   *
+   * @return The number of keys.
+   */
+  std::size_t size() const { return frozen ? slots.size() : entries.size(); }
+};
+
+} // namespace clob
\ No newline at end of file
@@ -6,13 +6,21 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace clob {
 
 using timestamp_ns_t = uint_fast64_t;
-using price_t = uint_fast32_t;
-using quantity_t = uint_fast32_t;
+using sequence_t = uint_fast64_t;
+using price_t = uint32_t;
+using quantity_t = uint32_t;
+using volume_t = uint_fast64_t;
 using balance_t = int_fast64_t;
 
+/**
+ * @brief Size of a cache line on the targets we care about.
+ */
+inline constexpr std::size_t cache_line_size{64};
+
 } // namespace clob
\ No newline at end of file
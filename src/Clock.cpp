@@ -0,0 +1,98 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif
+
+#include "clob/Clock.h"
+
+namespace clob {
+
+namespace {
+
+#ifdef CLOB_HAS_TSC
+struct TscCalibration {
+  std::uint64_t tsc_base;
+  timestamp_ns_t ns_base;
+  std::uint64_t ns_per_tick;
+};
+
+bool has_invariant_tsc() {
+  unsigned int regs[4]{};
+#if defined(__GNUC__)
+  if (__get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3]) == 0) {
+    return false;
+  }
+#else
+  int info[4]{};
+  __cpuid(info, 0x80000000);
+  if (static_cast<unsigned int>(info[0]) < 0x80000007) {
+    return false;
+  }
+  __cpuid(info, 0x80000007);
+  regs[3] = static_cast<unsigned int>(info[3]);
+#endif
+  return (regs[3] & (1u << 8)) != 0;
+}
+
+/**
+ * @brief Measure the tick period over a 10ms spin, or 0 if the counter is
+ * not usable.
+ */
+TscCalibration calibrate() {
+  if (!has_invariant_tsc()) {
+    return {0, 0, 0};
+  }
+  using std::chrono::steady_clock;
+  const auto start = steady_clock::now();
+  const std::uint64_t start_tsc = __rdtsc();
+  auto end = start;
+  do {
+    end = steady_clock::now();
+  } while (end - start < std::chrono::milliseconds{10});
+  const std::uint64_t end_tsc = __rdtsc();
+  const auto ns = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+          .count());
+  const std::uint64_t ns_per_tick = (ns << 32) / (end_tsc - start_tsc);
+  // Below 1GHz a tick no longer fits the 32 bits the conversion assumes.
+  if (ns_per_tick >= (std::uint64_t{1} << 32)) {
+    return {0, 0, 0};
+  }
+  const auto now = static_cast<timestamp_ns_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+  return {__rdtsc(), now, ns_per_tick};
+}
+#endif
+
+} // namespace
+
+bool Clock::configure(const ClockMode new_mode) {
+  if (new_mode == ClockMode::Tsc) {
+#ifdef CLOB_HAS_TSC
+    static const TscCalibration calibration = calibrate();
+    if (calibration.ns_per_tick == 0) {
+      return false;
+    }
+    tsc_base = calibration.tsc_base;
+    ns_base = calibration.ns_base;
+    ns_per_tick = calibration.ns_per_tick;
+#else
+    return false;
+#endif
+  }
+  mode = new_mode;
+  manual_ns = 0;
+  return true;
+}
+
+} // namespace clob
\ No newline at end of file
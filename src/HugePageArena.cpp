@@ -0,0 +1,241 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define CLOB_HAS_MMAP 1
+#endif
+
+#include "clob/HugePageArena.h"
+
+namespace clob {
+
+namespace {
+
+std::size_t round_up(const std::size_t size, const std::size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+#ifdef CLOB_HAS_MMAP
+void *map_pages(const std::size_t size, const int extra_flags) {
+  void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+  return data == MAP_FAILED ? nullptr : data;
+}
+#endif
+
+} // namespace
+
+HugePageArena::HugePageArena(const HugePageConfig &config) : config(config) {
+  configure(config);
+}
+
+HugePageArena::~HugePageArena() {
+  for (const Region &region : regions) {
+#ifdef CLOB_HAS_MMAP
+    if (region.mapped) {
+      munmap(region.data, region.size);
+      continue;
+    }
+#endif
+    ::operator delete(region.data, std::align_val_t{base_page_size});
+  }
+}
+
+bool HugePageArena::configure(const HugePageConfig &new_config) {
+  if (!regions.empty()) {
+    return false;
+  }
+  config = new_config;
+  if (config.page_size < base_page_size ||
+      !std::has_single_bit(config.page_size)) {
+    config.page_size = std::size_t{2} << 20;
+  }
+  config.region_size = round_up(
+      config.region_size == 0 ? config.page_size : config.region_size,
+      config.page_size);
+  return true;
+}
+
+void HugePageArena::map_region(const std::size_t min_size,
+                               const std::size_t alignment) {
+  const std::size_t size =
+      round_up(min_size + alignment > config.region_size
+                   ? min_size + alignment
+                   : config.region_size,
+               config.page_size);
+  Region region{nullptr, size, HugePageMode::Off, true};
+#ifdef CLOB_HAS_MMAP
+#ifdef MAP_HUGETLB
+  if (config.mode == HugePageMode::Explicit) {
+    int flags = MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+    flags |= std::countr_zero(config.page_size) << MAP_HUGE_SHIFT;
+#endif
+    region.data = static_cast<std::byte *>(map_pages(size, flags));
+    region.backing = HugePageMode::Explicit;
+  }
+#endif
+  if (region.data == nullptr) {
+    region.data = static_cast<std::byte *>(map_pages(size, 0));
+    region.backing = HugePageMode::Off;
+#ifdef MADV_HUGEPAGE
+    if (region.data != nullptr && config.mode != HugePageMode::Off &&
+        madvise(region.data, size, MADV_HUGEPAGE) == 0) {
+      region.backing = HugePageMode::Transparent;
+    }
+#endif
+  }
+#endif
+  if (region.data == nullptr) {
+    region.data = static_cast<std::byte *>(
+        ::operator new(size, std::align_val_t{base_page_size}));
+    region.mapped = false;
+  }
+  regions.push_back(region);
+  cursor = region.data;
+  end = region.data + size;
+}
+
+std::byte *HugePageArena::bump(const std::size_t bytes,
+                               const std::size_t alignment) {
+  auto aligned = [&] {
+    const auto address = reinterpret_cast<std::uintptr_t>(cursor);
+    return cursor + (round_up(address, alignment) - address);
+  };
+  if (cursor == nullptr || aligned() + bytes > end) {
+    map_region(bytes, alignment);
+  }
+  std::byte *block = aligned();
+  cursor = block + bytes;
+  return block;
+}
+
+bool HugePageArena::is_region_start(const std::byte *address) const {
+  for (const Region &region : regions) {
+    if (region.data == address) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void *HugePageArena::take_large(const std::size_t size) {
+  auto fit = large_free.end();
+  for (auto it = large_free.begin(); it != large_free.end(); ++it) {
+    if (it->second >= size &&
+        (fit == large_free.end() || it->second < fit->second)) {
+      fit = it;
+    }
+  }
+  if (fit == large_free.end()) {
+    return bump(size, base_page_size);
+  }
+  std::byte *block = fit->first;
+  if (fit->second == size) {
+    large_free.erase(fit);
+  } else {
+    fit->first += size;
+    fit->second -= size;
+  }
+  return block;
+}
+
+void HugePageArena::give_large(std::byte *block, std::size_t size) {
+  const Region &current = regions.back();
+  if (block + size == cursor && block >= current.data) {
+    cursor = block;
+    // Free blocks now ending at the bump pointer go back to it too.
+    while (!large_free.empty() &&
+           large_free.back().first + large_free.back().second == cursor &&
+           large_free.back().first >= current.data) {
+      cursor = large_free.back().first;
+      large_free.pop_back();
+    }
+    return;
+  }
+  auto next = std::lower_bound(
+      large_free.begin(), large_free.end(), block,
+      [](const auto &free_block, const std::byte *address) {
+        return free_block.first < address;
+      });
+  if (next != large_free.end() && block + size == next->first &&
+      !is_region_start(next->first)) {
+    size += next->second;
+    next = large_free.erase(next);
+  }
+  if (next != large_free.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == block && !is_region_start(block)) {
+      prev->second += size;
+      return;
+    }
+  }
+  large_free.insert(next, {block, size});
+}
+
+void *HugePageArena::do_allocate(const std::size_t bytes,
+                                 const std::size_t alignment) {
+  if (bytes > base_page_size) {
+    const std::size_t size = round_up(bytes, base_page_size);
+    bytes_in_use += size;
+    return take_large(size);
+  }
+  const std::size_t index = size_class(bytes);
+  const std::size_t size = std::size_t{1} << index;
+  // Small blocks are aligned to their size up to a cache line, so any free
+  // block of a class fits a request of no more than that alignment.
+  const std::size_t block_alignment =
+      size < cache_line_size ? size : cache_line_size;
+  bytes_in_use += size;
+  if (free_lists[index] != nullptr && alignment <= block_alignment) {
+    FreeBlock *block = free_lists[index];
+    free_lists[index] = block->next;
+    return block;
+  }
+  return bump(size, alignment > block_alignment ? alignment : block_alignment);
+}
+
+void HugePageArena::do_deallocate(void *block, const std::size_t bytes,
+                                  const std::size_t) {
+  if (bytes > base_page_size) {
+    const std::size_t size = round_up(bytes, base_page_size);
+    bytes_in_use -= size;
+    give_large(static_cast<std::byte *>(block), size);
+    return;
+  }
+  const std::size_t index = size_class(bytes);
+  bytes_in_use -= std::size_t{1} << index;
+  free_lists[index] = ::new (block) FreeBlock{free_lists[index]};
+}
+
+HugePageStats HugePageArena::stats() const {
+  HugePageStats stats{config.page_size, 0, 0, 0};
+  for (const Region &region : regions) {
+    switch (region.backing) {
+    case HugePageMode::Explicit:
+      stats.huge_pages += region.size / config.page_size;
+      break;
+    case HugePageMode::Transparent:
+      stats.transparent_pages += region.size / config.page_size;
+      break;
+    case HugePageMode::Off:
+      stats.normal_pages += region.size / base_page_size;
+      break;
+    }
+  }
+  return stats;
+}
+
+} // namespace clob
\ No newline at end of file
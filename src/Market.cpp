@@ -4,76 +4,416 @@
  * Distributed under the MIT License (http://opensource.org/licenses/MIT)
  */
 
-#include <chrono>
-#include <memory>
+#include <cstdint>
+#include <string>
 #include <utility>
 
 #include "clob/LimitOrder.h"
 #include "clob/Market.h"
+#include "clob/ReferenceFile.h"
 #include "clob/Stock.h"
 
 namespace clob {
 
-std::string Market::get_exchange_name() const { return exchange_name; }
+namespace {
 
-std::string Market::get_exchange_ticker() const { return exchange_ticker; }
+template <typename Config> Config book_config(const price_t tick_size) {
+  Config config{};
+  if constexpr (requires { config.tick_size; }) {
+    config.tick_size = tick_size;
+  }
+  return config;
+}
+
+} // namespace
 
 std::size_t Market::get_num_stocks() const { return stocks.size(); }
 
+void Market::reserve(const std::size_t max_symbols,
+                     const std::size_t max_orders) {
+  stocks.reserve(max_symbols);
+  tickers.reserve(max_symbols);
+  order_books.reserve(max_symbols);
+  traded_volume.reserve(max_symbols);
+  orders.reserve(max_orders);
+}
+
+bool Market::emplace_stock(const std::string_view stock_name,
+                           const std::string_view stock_ticker,
+                           const price_t tick_size,
+                           const quantity_t lot_size) {
+  if (!tickers.insert(TickerIndex::pack(stock_ticker),
+                      static_cast<TickerIndex::value_t>(get_num_stocks()))) {
+    return false;
+  }
+  const std::string_view name = strings.append(stock_name);
+  stocks.emplace_back(name, strings.append(stock_ticker),
+                      static_cast<Stock::id_t>(get_num_stocks()), tick_size,
+                      lot_size);
+  order_books.emplace_back(book_config<OrderBook::config_t>(tick_size),
+                           OrderBook::allocator_type(resource))
+      .set_filled_handler(&Market::on_order_filled, this);
+  traded_volume.push_back(0);
+  return true;
+}
+
 bool Market::add_stock(const std::string &stock_name,
                        const std::string &stock_ticker) {
-  stocks.emplace_back(stock_name, stock_ticker,
-                      static_cast<Stock::id_t>(get_num_stocks()));
-  order_books.emplace_back();
-  return true;
+  return emplace_stock(stock_name, stock_ticker, 1, 1);
 }
 
 bool Market::add_stock(std::string &&stock_name, std::string &&stock_ticker) {
-  stocks.emplace_back(std::move(stock_name), std::move(stock_ticker),
-                      static_cast<Stock::id_t>(get_num_stocks()));
-  order_books.emplace_back();
-  return true;
+  return emplace_stock(stock_name, stock_ticker, 1, 1);
+}
+
+std::size_t Market::load_universe(const std::string &path) {
+  ReferenceFile file;
+  if (!file.open(path)) {
+    return 0;
+  }
+  reserve(get_num_stocks() + file.size(), 0);
+  strings.reserve(file.size_bytes());
+  std::size_t num_added{0};
+  ReferenceRecord record;
+  while (file.read(record)) {
+    num_added += emplace_stock(record.name, record.ticker, record.tick_size,
+                               record.lot_size);
+  }
+  return num_added;
+}
+
+const Stock *Market::find_stock(const TickerIndex::key_t ticker) const {
+  TickerIndex::value_t stock_id;
+  if (!tickers.find(ticker, stock_id)) {
+    return nullptr;
+  }
+  return &stocks[stock_id];
+}
+
+void Market::on_order_filled(void *context, LimitOrder *order) {
+  Market *market = static_cast<Market *>(context);
+  market->orders.set_terminal(OrderStore::handle_of(order->id),
+                              market->event_ns);
+}
+
+void Market::settle_order(const clob::Stock::id_t stock_id,
+                          LimitOrder *order) {
+  // Every trade has the new order on one side, so its fills count each
+  // traded quantity once.
+  traded_volume[stock_id] += order->filled_quantity;
+  if (order->level == nullptr) {
+    orders.set_terminal(OrderStore::handle_of(order->id), event_ns);
+  }
 }
 
 template <clob::LimitOrder::OrderType order_type>
+LimitOrder *Market::accept_order(const clob::Stock::id_t stock_id,
+                                 const clob::price_t price,
+                                 const clob::quantity_t quantity) {
+  const timestamp_ns_t ns = clock.now();
+  event_ns = ns;
+  const sequence_t sequence = next_sequence++;
+  if (archive.is_open() && orders.size() % OrderStore::chunk_size == 0) {
+    archive_terminal_orders();
+  }
+  LimitOrder *order = nullptr;
+  if (order_capacity != 0 && orders.size() >= order_capacity) {
+    order = find_reusable_slot();
+  }
+  if (order != nullptr) {
+    order = orders.reuse(OrderStore::handle_of(order->id),
+                         static_cast<std::uint32_t>(stock_id), order_type, ns,
+                         sequence, price, quantity);
+  } else {
+    order = orders.create(static_cast<std::uint32_t>(stock_id), order_type, ns,
+                          sequence, price, quantity);
+  }
+  if (stock_id >= order_books.size()) {
+    order->is_cancelled = true;
+    orders.set_terminal(OrderStore::handle_of(order->id), ns);
+  }
+  return order;
+}
+
+template <clob::LimitOrder::OrderType order_type,
+          clob::LimitOrder::TimeInForce time_in_force>
 clob::LimitOrder::id_t Market::add_order(const clob::Stock::id_t stock_id,
                                          const clob::price_t price,
                                          const clob::quantity_t quantity) {
-  auto ns = std::chrono::system_clock::now().time_since_epoch().count();
-  clob::LimitOrder::id_t order_id =
-      static_cast<LimitOrder::id_t>(orders.size());
-  orders.emplace_back(
-      std::make_unique<LimitOrder>(order_id, ns, price, quantity));
-  if (stock_id >= order_books.size()) {
-    orders.back()->is_cancelled = true;
-    return order_id;
+  using TimeInForce = LimitOrder::TimeInForce;
+  LimitOrder *order = accept_order<order_type>(stock_id, price, quantity);
+  if (order->is_cancelled) {
+    return order->id;
+  }
+  OrderBook &order_book = order_books[stock_id];
+  if constexpr (order_type == LimitOrder::OrderType::Bid) {
+    if constexpr (time_in_force == TimeInForce::Ioc) {
+      order_book.add_ioc_bid_order(order);
+    } else if constexpr (time_in_force == TimeInForce::Fok) {
+      order_book.add_fok_bid_order(order);
+    } else {
+      order_book.add_bid_order(order);
+    }
+  } else {
+    if constexpr (time_in_force == TimeInForce::Ioc) {
+      order_book.add_ioc_ask_order(order);
+    } else if constexpr (time_in_force == TimeInForce::Fok) {
+      order_book.add_fok_ask_order(order);
+    } else {
+      order_book.add_ask_order(order);
+    }
+  }
+  settle_order(stock_id, order);
+  return order->id;
+}
+
+template <clob::LimitOrder::OrderType order_type>
+clob::LimitOrder::id_t
+Market::add_market_order(const clob::Stock::id_t stock_id,
+                         const clob::quantity_t quantity) {
+  LimitOrder *order = accept_order<order_type>(stock_id, 0, quantity);
+  if (order->is_cancelled) {
+    return order->id;
+  }
+  if constexpr (order_type == LimitOrder::OrderType::Bid) {
+    order_books[stock_id].add_market_bid_order(order);
+  } else {
+    order_books[stock_id].add_market_ask_order(order);
+  }
+  settle_order(stock_id, order);
+  return order->id;
+}
+
+template <clob::LimitOrder::OrderType order_type>
+clob::LimitOrder::id_t
+Market::add_market_order(const clob::Stock::id_t stock_id,
+                         const clob::quantity_t quantity,
+                         const clob::price_t band) {
+  LimitOrder *order = accept_order<order_type>(stock_id, 0, quantity);
+  if (order->is_cancelled) {
+    return order->id;
+  }
+  if constexpr (order_type == LimitOrder::OrderType::Bid) {
+    order_books[stock_id].add_market_bid_order(order, band);
+  } else {
+    order_books[stock_id].add_market_ask_order(order, band);
+  }
+  settle_order(stock_id, order);
+  return order->id;
+}
+
+template <clob::LimitOrder::OrderType order_type>
+clob::LimitOrder::id_t
+Market::add_post_only_order(const clob::Stock::id_t stock_id,
+                            const clob::price_t price,
+                            const clob::quantity_t quantity,
+                            const clob::LimitOrder::PostOnly post_only) {
+  LimitOrder *order = accept_order<order_type>(stock_id, price, quantity);
+  if (order->is_cancelled) {
+    return order->id;
   }
   if constexpr (order_type == LimitOrder::OrderType::Bid) {
-    order_books[stock_id].add_bid_order(orders.back().get());
+    order_books[stock_id].add_post_only_bid_order(order, post_only);
   } else {
-    order_books[stock_id].add_ask_order(orders.back().get());
+    order_books[stock_id].add_post_only_ask_order(order, post_only);
   }
-  return order_id;
+  settle_order(stock_id, order);
+  return order->id;
 }
 
 bool Market::cancel_order(const clob::LimitOrder::id_t order_id) {
-  if (order_id >= orders.size()) {
+  const OrderStore::handle_t handle = OrderStore::handle_of(order_id);
+  if (handle >= orders.size() || !orders.is_resident(handle)) {
     return false;
   }
-  auto &order = orders[order_id];
-  if (order->is_cancelled || order->filled_quantity == order->quantity) {
+  LimitOrder *order = orders.get(handle);
+  if (order->id != order_id || !orders.is_live(handle)) {
     return false;
   }
-  order->is_cancelled = true;
-  return true;
+  OrderBook &order_book = order_books[orders.stock_id(handle)];
+  const bool cancelled =
+      orders.order_type(handle) == LimitOrder::OrderType::Bid
+          ? order_book.cancel_bid_order(order)
+          : order_book.cancel_ask_order(order);
+  orders.set_terminal(handle, clock.now());
+  return cancelled;
+}
+
+bool Market::modify_order(const clob::LimitOrder::id_t order_id,
+                          const clob::price_t price,
+                          const clob::quantity_t quantity) {
+  const OrderStore::handle_t handle = OrderStore::handle_of(order_id);
+  if (handle >= orders.size() || !orders.is_resident(handle)) {
+    return false;
+  }
+  LimitOrder *order = orders.get(handle);
+  if (order->id != order_id || !orders.is_live(handle)) {
+    return false;
+  }
+  const sequence_t sequence = next_sequence++;
+  event_ns = clock.now();
+  const std::uint32_t stock_id = orders.stock_id(handle);
+  OrderBook &order_book = order_books[stock_id];
+  const quantity_t filled = order->filled_quantity;
+  const bool modified =
+      orders.order_type(handle) == LimitOrder::OrderType::Bid
+          ? order_book.modify_bid_order(order, price, quantity, sequence)
+          : order_book.modify_ask_order(order, price, quantity, sequence);
+  if (order->sequence == sequence) {
+    orders.set_timestamp(handle, event_ns);
+  }
+  // A re-queued order may trade as it crosses, like a new order.
+  traded_volume[stock_id] += order->filled_quantity - filled;
+  if (order->level == nullptr) {
+    orders.set_terminal(handle, event_ns);
+  }
+  return modified;
+}
+
+std::size_t Market::cancel_all_orders(const clob::Stock::id_t stock_id) {
+  if (stock_id >= order_books.size()) {
+    return 0;
+  }
+  OrderBook &order_book = order_books[stock_id];
+  const timestamp_ns_t ns = clock.now();
+  std::size_t num_cancelled{0};
+  orders.for_each_live_order(
+      static_cast<std::uint32_t>(stock_id),
+      [&](const OrderStore::handle_t handle) {
+        LimitOrder *order = orders.get(handle);
+        num_cancelled +=
+            orders.order_type(handle) == LimitOrder::OrderType::Bid
+                ? order_book.cancel_bid_order(order)
+                : order_book.cancel_ask_order(order);
+        orders.set_terminal(handle, ns);
+      });
+  return num_cancelled;
+}
+
+volume_t Market::get_traded_volume(const clob::Stock::id_t stock_id) const {
+  if (stock_id >= order_books.size()) {
+    return 0;
+  }
+  return traded_volume[stock_id];
 }
 
 const LimitOrder *
 Market::query_order(const clob::LimitOrder::id_t order_id) const {
-  if (order_id >= orders.size()) {
+  const OrderStore::handle_t handle = OrderStore::handle_of(order_id);
+  if (handle >= orders.size()) {
     return nullptr;
   }
-  return orders[order_id].get();
+  if (!orders.is_resident(handle)) {
+    return nullptr;
+  }
+  const LimitOrder *order = orders.get(handle);
+  return order->id == order_id ? order : nullptr;
+}
+
+bool Market::query_archived_order(const clob::LimitOrder::id_t order_id,
+                                  ArchivedOrder &order) const {
+  const OrderStore::handle_t handle = OrderStore::handle_of(order_id);
+  if (handle >= orders.size() || orders.is_resident(handle)) {
+    return false;
+  }
+  return archive.read(order_id, order);
+}
+
+bool Market::get_order_timestamp(const clob::LimitOrder::id_t order_id,
+                                 timestamp_ns_t &timestamp) const {
+  const OrderStore::handle_t handle = OrderStore::handle_of(order_id);
+  if (handle >= orders.size()) {
+    return false;
+  }
+  if (orders.is_resident(handle)) {
+    if (orders.get(handle)->id != order_id) {
+      return false;
+    }
+    timestamp = orders.timestamp(handle);
+    return true;
+  }
+  ArchivedOrder archived;
+  if (!archive.read(order_id, archived)) {
+    return false;
+  }
+  timestamp = archived.timestamp;
+  return true;
+}
+
+bool Market::set_order_capacity(const std::size_t capacity) {
+  if (orders.size() != 0 || archive.is_open()) {
+    return false;
+  }
+  order_capacity = capacity;
+  return true;
+}
+
+LimitOrder *Market::find_reusable_slot() {
+  const std::size_t size = orders.size();
+  for (std::size_t step = 0; step < size; ++step) {
+    const auto handle = static_cast<OrderStore::handle_t>(reclaim_cursor);
+    reclaim_cursor = reclaim_cursor + 1 == size ? 0 : reclaim_cursor + 1;
+    if (!orders.is_live(handle)) {
+      return orders.get(handle);
+    }
+  }
+  // Every order is live, grow by a chunk before sweeping again.
+  order_capacity = size + OrderStore::chunk_size;
+  return nullptr;
+}
+
+bool Market::set_retention_policy(const std::string &archive_path,
+                                  const timestamp_ns_t delay_ns) {
+  if (order_capacity != 0) {
+    return false;
+  }
+  retention_delay_ns = delay_ns;
+  return archive.open(archive_path);
+}
+
+bool Market::is_retired(const std::size_t chunk,
+                        const timestamp_ns_t now) const {
+  return orders.num_live(chunk) == 0 &&
+         orders.last_terminal(chunk) + retention_delay_ns <= now;
+}
+
+std::size_t Market::archive_terminal_orders() {
+  if (!archive.is_open()) {
+    return 0;
+  }
+  const timestamp_ns_t now = clock.now();
+  // Only full chunks are retired, the last one may still be filling up.
+  const std::size_t num_full = orders.size() >> OrderStore::chunk_bits;
+  const auto first_of = [](const std::size_t chunk) {
+    return static_cast<OrderStore::handle_t>(chunk << OrderStore::chunk_bits);
+  };
+  while (archive_cursor < num_full &&
+         !orders.is_resident(first_of(archive_cursor))) {
+    ++archive_cursor;
+  }
+  std::size_t num_archived{0};
+  for (std::size_t chunk = archive_cursor; chunk < num_full; ++chunk) {
+    const OrderStore::handle_t first = first_of(chunk);
+    if (!orders.is_resident(first) || !is_retired(chunk, now)) {
+      continue;
+    }
+    archive_buffer.clear();
+    for (std::size_t i = 0; i < OrderStore::chunk_size; ++i) {
+      const auto handle = static_cast<OrderStore::handle_t>(first + i);
+      const LimitOrder *order = orders.get(handle);
+      archive_buffer.push_back(
+          {order->id, orders.timestamp(handle), order->sequence,
+           order->balance, order->price, order->quantity,
+           order->filled_quantity, orders.stock_id(handle),
+           orders.order_type(handle), order->is_cancelled});
+    }
+    if (!archive.append(chunk, archive_buffer)) {
+      return num_archived;
+    }
+    orders.release_chunk(chunk);
+    num_archived += OrderStore::chunk_size;
+  }
+  return num_archived;
 }
 
 const OrderBook *
@@ -88,5 +428,39 @@ template clob::LimitOrder::id_t Market::add_order<LimitOrder::OrderType::Bid>(
     const clob::Stock::id_t, const clob::price_t, const clob::quantity_t);
 template clob::LimitOrder::id_t Market::add_order<LimitOrder::OrderType::Ask>(
     const clob::Stock::id_t, const clob::price_t, const clob::quantity_t);
+template clob::LimitOrder::id_t
+Market::add_order<LimitOrder::OrderType::Bid, LimitOrder::TimeInForce::Ioc>(
+    const clob::Stock::id_t, const clob::price_t, const clob::quantity_t);
+template clob::LimitOrder::id_t
+Market::add_order<LimitOrder::OrderType::Ask, LimitOrder::TimeInForce::Ioc>(
+    const clob::Stock::id_t, const clob::price_t, const clob::quantity_t);
+template clob::LimitOrder::id_t
+Market::add_order<LimitOrder::OrderType::Bid, LimitOrder::TimeInForce::Fok>(
+    const clob::Stock::id_t, const clob::price_t, const clob::quantity_t);
+template clob::LimitOrder::id_t
+Market::add_order<LimitOrder::OrderType::Ask, LimitOrder::TimeInForce::Fok>(
+    const clob::Stock::id_t, const clob::price_t, const clob::quantity_t);
+template clob::LimitOrder::id_t
+Market::add_market_order<LimitOrder::OrderType::Bid>(const clob::Stock::id_t,
+                                                     const clob::quantity_t);
+template clob::LimitOrder::id_t
+Market::add_market_order<LimitOrder::OrderType::Ask>(const clob::Stock::id_t,
+                                                     const clob::quantity_t);
+template clob::LimitOrder::id_t
+Market::add_market_order<LimitOrder::OrderType::Bid>(const clob::Stock::id_t,
+                                                     const clob::quantity_t,
+                                                     const clob::price_t);
+template clob::LimitOrder::id_t
+Market::add_market_order<LimitOrder::OrderType::Ask>(const clob::Stock::id_t,
+                                                     const clob::quantity_t,
+                                                     const clob::price_t);
+template clob::LimitOrder::id_t
+Market::add_post_only_order<LimitOrder::OrderType::Bid>(
+    const clob::Stock::id_t, const clob::price_t, const clob::quantity_t,
+    const clob::LimitOrder::PostOnly);
+template clob::LimitOrder::id_t
+Market::add_post_only_order<LimitOrder::OrderType::Ask>(
+    const clob::Stock::id_t, const clob::price_t, const clob::quantity_t,
+    const clob::LimitOrder::PostOnly);
 
 } // namespace clob
\ No newline at end of file
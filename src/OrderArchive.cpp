@@ -0,0 +1,78 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#endif
+
+#include "clob/OrderArchive.h"
+
+namespace clob {
+
+namespace {
+
+int seek(std::FILE *file, const std::int64_t offset) {
+#ifdef _WIN32
+  return _fseeki64(file, offset, SEEK_SET);
+#else
+  return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+} // namespace
+
+bool OrderArchive::open(const std::string &path) {
+  file.reset(std::fopen(path.c_str(), "w+b"));
+  block_offsets.clear();
+  end_offset = 0;
+  num_orders = 0;
+  return file != nullptr;
+}
+
+bool OrderArchive::append(const std::size_t block,
+                          std::span<const ArchivedOrder> orders) {
+  if (file == nullptr || orders.size() > block_size) {
+    return false;
+  }
+  if (block < block_offsets.size() && block_offsets[block] >= 0) {
+    return false;
+  }
+  if (seek(file.get(), end_offset) != 0 ||
+      std::fwrite(orders.data(), sizeof(ArchivedOrder), orders.size(),
+                  file.get()) != orders.size() ||
+      std::fflush(file.get()) != 0) {
+    return false;
+  }
+  if (block >= block_offsets.size()) {
+    block_offsets.resize(block + 1, -1);
+  }
+  block_offsets[block] = end_offset;
+  end_offset += static_cast<std::int64_t>(orders.size_bytes());
+  num_orders += orders.size();
+  return true;
+}
+
+bool OrderArchive::read(const std::uint64_t id, ArchivedOrder &order) const {
+  const std::size_t block = id / block_size;
+  if (file == nullptr || block >= block_offsets.size() ||
+      block_offsets[block] < 0) {
+    return false;
+  }
+  const std::int64_t offset =
+      block_offsets[block] +
+      static_cast<std::int64_t>((id % block_size) * sizeof(ArchivedOrder));
+  if (offset >= end_offset) {
+    return false;
+  }
+  return seek(file.get(), offset) == 0 &&
+         std::fread(&order, sizeof(ArchivedOrder), 1, file.get()) == 1 &&
+         order.id == id;
+}
+
+} // namespace clob
\ No newline at end of file
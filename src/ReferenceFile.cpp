@@ -0,0 +1,259 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CLOB_HAS_MMAP 1
+#endif
+
+#include "clob/ReferenceFile.h"
+
+namespace clob {
+
+namespace {
+
+struct FileCloser {
+  void operator()(std::FILE *file) const { std::fclose(file); }
+};
+
+using file_ptr_t = std::unique_ptr<std::FILE, FileCloser>;
+
+bool read_whole(const std::string &path, std::vector<char> &buffer) {
+  const file_ptr_t file{std::fopen(path.c_str(), "rb")};
+  if (file == nullptr) {
+    return false;
+  }
+  buffer.clear();
+  char block[65536];
+  std::size_t count;
+  while ((count = std::fread(block, 1, sizeof(block), file.get())) != 0) {
+    buffer.insert(buffer.end(), block, block + count);
+  }
+  return std::ferror(file.get()) == 0;
+}
+
+/**
+ * @brief Cut the line starting at cursor, without its line terminator, and
+ * move cursor past it.
+ */
+std::string_view next_line(const char *data, const std::size_t size,
+                           std::size_t &cursor) {
+  const char *begin = data + cursor;
+  const auto *newline =
+      static_cast<const char *>(std::memchr(begin, '\n', size - cursor));
+  const std::size_t length = newline == nullptr
+                                 ? size - cursor
+                                 : static_cast<std::size_t>(newline - begin);
+  cursor += newline == nullptr ? length : length + 1;
+  std::string_view line{begin, length};
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+  return line;
+}
+
+template <typename T>
+bool parse_number(const std::string_view field, T &value) {
+  const auto [end, error] =
+      std::from_chars(field.data(), field.data() + field.size(), value);
+  return error == std::errc{} && end == field.data() + field.size();
+}
+
+} // namespace
+
+void ReferenceFile::close() {
+#ifdef CLOB_HAS_MMAP
+  if (mapped) {
+    munmap(const_cast<char *>(data), data_size);
+  }
+#endif
+  data = nullptr;
+  data_size = 0;
+  mapped = false;
+  buffer.clear();
+  binary = false;
+  num_records = 0;
+  next_record = 0;
+  cursor = 0;
+}
+
+bool ReferenceFile::open(const std::string &path) {
+  close();
+#ifdef CLOB_HAS_MMAP
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info {};
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    void *view = mmap(nullptr, static_cast<std::size_t>(info.st_size),
+                      PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+      madvise(view, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+#endif
+      data = static_cast<const char *>(view);
+      data_size = static_cast<std::size_t>(info.st_size);
+      mapped = true;
+    }
+  }
+  ::close(fd);
+#endif
+  if (!mapped) {
+    if (!read_whole(path, buffer)) {
+      return false;
+    }
+    data = buffer.data();
+    data_size = buffer.size();
+  }
+  if (data_size >= header_size &&
+      std::string_view{data, magic.size()} == magic) {
+    binary = true;
+    if (!open_binary()) {
+      close();
+      return false;
+    }
+    return true;
+  }
+  open_csv();
+  return true;
+}
+
+bool ReferenceFile::open_binary() {
+  std::uint32_t count;
+  std::memcpy(&count, data + magic.size(), sizeof(count));
+  if ((data_size - header_size) / sizeof(BinaryRecord) < count) {
+    return false;
+  }
+  num_records = count;
+  return true;
+}
+
+void ReferenceFile::open_csv() {
+  std::size_t position{0};
+  bool first = true;
+  while (position < data_size) {
+    const std::size_t start = position;
+    const std::string_view line = next_line(data, data_size, position);
+    if (line.empty()) {
+      continue;
+    }
+    if (first && line.starts_with("name,")) {
+      cursor = position;
+    } else {
+      if (first) {
+        cursor = start;
+      }
+      ++num_records;
+    }
+    first = false;
+  }
+}
+
+bool ReferenceFile::read(ReferenceRecord &record) {
+  if (next_record == num_records) {
+    return false;
+  }
+  if (!(binary ? read_binary(record) : read_csv(record)) ||
+      record.tick_size == 0 || record.lot_size == 0) {
+    return false;
+  }
+  ++next_record;
+  return true;
+}
+
+bool ReferenceFile::read_binary(ReferenceRecord &record) {
+  const char *raw = data + header_size + next_record * sizeof(BinaryRecord);
+  BinaryRecord fields;
+  std::memcpy(&fields, raw, sizeof(fields));
+  const std::size_t names = header_size + num_records * sizeof(BinaryRecord);
+  if (fields.name_offset > data_size - names ||
+      fields.name_size > data_size - names - fields.name_offset) {
+    return false;
+  }
+  record.name = {data + names + fields.name_offset, fields.name_size};
+  std::size_t ticker_size{0};
+  while (ticker_size < sizeof(fields.ticker) &&
+         fields.ticker[ticker_size] != '\0') {
+    ++ticker_size;
+  }
+  record.ticker = {raw + offsetof(BinaryRecord, ticker), ticker_size};
+  record.tick_size = fields.tick_size;
+  record.lot_size = fields.lot_size;
+  return true;
+}
+
+bool ReferenceFile::read_csv(ReferenceRecord &record) {
+  std::string_view line;
+  while (line.empty() && cursor < data_size) {
+    line = next_line(data, data_size, cursor);
+  }
+  std::string_view fields[4];
+  for (std::size_t i = 0; i < 3; ++i) {
+    const std::size_t comma = line.find(',');
+    if (comma == std::string_view::npos) {
+      return false;
+    }
+    fields[i] = line.substr(0, comma);
+    line.remove_prefix(comma + 1);
+  }
+  fields[3] = line;
+  record.name = fields[0];
+  record.ticker = fields[1];
+  return parse_number(fields[2], record.tick_size) &&
+         parse_number(fields[3], record.lot_size);
+}
+
+bool ReferenceFile::write(const std::string &path,
+                          std::span<const ReferenceRecord> records) {
+  std::vector<BinaryRecord> raw(records.size());
+  std::size_t name_offset{0};
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    const ReferenceRecord &record = records[i];
+    if (record.ticker.size() > sizeof(raw[i].ticker) ||
+        name_offset + record.name.size() > UINT32_MAX) {
+      return false;
+    }
+    std::memset(raw[i].ticker, 0, sizeof(raw[i].ticker));
+    std::memcpy(raw[i].ticker, record.ticker.data(), record.ticker.size());
+    raw[i].tick_size = record.tick_size;
+    raw[i].lot_size = record.lot_size;
+    raw[i].name_offset = static_cast<std::uint32_t>(name_offset);
+    raw[i].name_size = static_cast<std::uint32_t>(record.name.size());
+    name_offset += record.name.size();
+  }
+  if (records.size() > UINT32_MAX) {
+    return false;
+  }
+  const file_ptr_t file{std::fopen(path.c_str(), "wb")};
+  if (file == nullptr) {
+    return false;
+  }
+  const std::uint32_t header[2]{static_cast<std::uint32_t>(records.size()),
+                                0};
+  bool written =
+      std::fwrite(magic.data(), 1, magic.size(), file.get()) == magic.size() &&
+      std::fwrite(header, sizeof(header), 1, file.get()) == 1 &&
+      std::fwrite(raw.data(), sizeof(BinaryRecord), raw.size(), file.get()) ==
+          raw.size();
+  for (std::size_t i = 0; written && i < records.size(); ++i) {
+    written = std::fwrite(records[i].name.data(), 1, records[i].name.size(),
+                          file.get()) == records[i].name.size();
+  }
+  return written && std::fflush(file.get()) == 0;
+}
+
+} // namespace clob
\ No newline at end of file
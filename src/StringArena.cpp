@@ -0,0 +1,46 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <cstring>
+
+#include "clob/StringArena.h"
+
+namespace clob {
+
+StringArena::~StringArena() {
+  for (const Block &block : blocks) {
+    resource->deallocate(block.data, block.size, 1);
+  }
+}
+
+void StringArena::add_block(const std::size_t min_size) {
+  const std::size_t size = min_size > block_size ? min_size : block_size;
+  blocks.push_back({static_cast<char *>(resource->allocate(size, 1)), size});
+  cursor = blocks.back().data;
+  end = cursor + size;
+}
+
+std::string_view StringArena::append(const std::string_view text) {
+  if (static_cast<std::size_t>(end - cursor) < text.size()) {
+    add_block(text.size());
+  }
+  if (!text.empty()) {
+    std::memcpy(cursor, text.data(), text.size());
+  }
+  const std::string_view stored{cursor, text.size()};
+  cursor += text.size();
+  num_bytes += text.size();
+  ++num_strings;
+  return stored;
+}
+
+void StringArena::reserve(const std::size_t bytes) {
+  if (static_cast<std::size_t>(end - cursor) < bytes) {
+    add_block(bytes);
+  }
+}
+
+} // namespace clob
\ No newline at end of file
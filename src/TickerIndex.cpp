@@ -0,0 +1,98 @@
+/**
+ * @page copyright
+ * Copyright(c) 2025-present, Nathanael Lu.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "clob/TickerIndex.h"
+
+namespace clob {
+
+namespace {
+
+// Tries per bucket before giving up, far beyond what a bucket of a table
+// with one free slot left needs on average.
+constexpr std::uint64_t max_pilot_tries{std::uint64_t{1} << 24};
+
+} // namespace
+
+bool TickerIndex::freeze() {
+  if (frozen) {
+    return true;
+  }
+  const std::size_t num_keys = entries.size();
+  // Two keys per bucket on average, so a pilot costs four bytes per key.
+  const std::size_t num_buckets = num_keys / 2 + 1;
+
+  // Group the keys by bucket, then place the largest buckets first while the
+  // table is still mostly free.
+  std::vector<std::uint32_t> bucket_start(num_buckets + 1, 0);
+  for (const auto &[key, value] : entries) {
+    ++bucket_start[reduce(mix(key), num_buckets) + 1];
+  }
+  std::partial_sum(bucket_start.begin(), bucket_start.end(),
+                   bucket_start.begin());
+  std::vector<Slot> grouped(num_keys);
+  std::vector<std::uint32_t> fill(bucket_start.begin(), bucket_start.end() - 1);
+  for (const auto &[key, value] : entries) {
+    grouped[fill[reduce(mix(key), num_buckets)]++] = {key, value};
+  }
+  std::vector<std::uint32_t> order(num_buckets);
+  std::iota(order.begin(), order.end(), std::uint32_t{0});
+  std::stable_sort(order.begin(), order.end(),
+                   [&](const std::uint32_t a, const std::uint32_t b) {
+                     return bucket_start[a + 1] - bucket_start[a] >
+                            bucket_start[b + 1] - bucket_start[b];
+                   });
+
+  std::pmr::vector<std::uint64_t> new_pilots(num_buckets, 0, resource);
+  std::pmr::vector<Slot> new_slots(num_keys, Slot{0, 0}, resource);
+  std::vector<bool> taken(num_keys, false);
+  std::vector<std::size_t> positions;
+  for (const std::uint32_t bucket : order) {
+    const std::uint32_t first = bucket_start[bucket];
+    const std::uint32_t last = bucket_start[bucket + 1];
+    if (first == last) {
+      break;
+    }
+    bool placed = false;
+    for (std::uint64_t seed = 1; !placed && seed <= max_pilot_tries; ++seed) {
+      const std::uint64_t pilot = mix(seed);
+      positions.clear();
+      placed = true;
+      for (std::uint32_t i = first; i < last; ++i) {
+        const std::size_t position =
+            slot_of(mix(grouped[i].key), pilot, num_keys);
+        if (taken[position] || std::find(positions.begin(), positions.end(),
+                                         position) != positions.end()) {
+          placed = false;
+          break;
+        }
+        positions.push_back(position);
+      }
+      if (placed) {
+        new_pilots[bucket] = pilot;
+        for (std::uint32_t i = first; i < last; ++i) {
+          taken[positions[i - first]] = true;
+          new_slots[positions[i - first]] = grouped[i];
+        }
+      }
+    }
+    if (!placed) {
+      return false;
+    }
+  }
+
+  pilots = std::move(new_pilots);
+  slots = std::move(new_slots);
+  entries = std::pmr::unordered_map<key_t, value_t>(resource);
+  frozen = true;
+  return true;
+}
+
+} // namespace clob
\ No newline at end of file
@@ -1 +1,31 @@
-#pragma once
\ No newline at end of file
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @brief A memory resource counting the allocations it forwards upstream.
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+  std::size_t allocations{0};
+  std::size_t allocated_bytes{0};
+
+private:
+  void *do_allocate(const std::size_t bytes,
+                    const std::size_t alignment) override {
+    ++allocations;
+    allocated_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, const std::size_t bytes,
+                     const std::size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource &other) const
+      noexcept override {
+    return this == &other;
+  }
+};
\ No newline at end of file
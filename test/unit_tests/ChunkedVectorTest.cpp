@@ -0,0 +1,102 @@
+#include "doctest/doctest.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/ChunkedVector.h"
+
+TEST_SUITE_BEGIN("ChunkedVector");
+
+using namespace clob;
+
+namespace {
+
+/**
+ * @brief Neither copyable nor movable, counts live instances.
+ */
+struct Pinned {
+  static inline int live{0};
+  int value;
+
+  explicit Pinned(const int value) : value(value) { ++live; }
+  Pinned(const Pinned &) = delete;
+  Pinned &operator=(const Pinned &) = delete;
+  ~Pinned() { --live; }
+};
+
+} // namespace
+
+/***/
+TEST_CASE("chunked_vector_emplace_back") {
+  ChunkedVector<int, 4> values;
+  CHECK(values.empty());
+  CHECK(values.capacity() == 0);
+  for (int i = 0; i < 10; ++i) {
+    CHECK(values.emplace_back(i) == i);
+  }
+  CHECK(values.size() == 10);
+  CHECK(values.capacity() == 12);
+  CHECK(values[0] == 0);
+  CHECK(values[9] == 9);
+  values[4] = 40;
+  const auto &const_values = values;
+  CHECK(const_values[4] == 40);
+}
+
+/***/
+TEST_CASE("chunked_vector_pointer_stability") {
+  {
+    ChunkedVector<Pinned, 8> pinned;
+    std::vector<const Pinned *> addresses;
+    for (int i = 0; i < 100; ++i) {
+      addresses.push_back(&pinned.emplace_back(i));
+    }
+    CHECK(Pinned::live == 100);
+    bool stable{true};
+    for (int i = 0; i < 100; ++i) {
+      stable = stable && &pinned[static_cast<std::size_t>(i)] ==
+                             addresses[static_cast<std::size_t>(i)] &&
+               addresses[static_cast<std::size_t>(i)]->value == i;
+    }
+    CHECK(stable);
+  }
+  CHECK(Pinned::live == 0);
+}
+
+/***/
+TEST_CASE("chunked_vector_reserve") {
+  ChunkedVector<int, 4> values;
+  values.reserve(9);
+  CHECK(values.capacity() == 12);
+  CHECK(values.empty());
+  values.emplace_back(1);
+  const int *first = &values[0];
+  for (int i = 0; i < 11; ++i) {
+    values.emplace_back(i);
+  }
+  CHECK(values.capacity() == 12);
+  CHECK(&values[0] == first);
+  values.reserve(4);
+  CHECK(values.capacity() == 12);
+}
+
+/***/
+TEST_CASE("chunked_vector_memory_resource") {
+  std::pmr::monotonic_buffer_resource resource;
+  {
+    ChunkedVector<Pinned, 4> values{&resource};
+    for (int i = 0; i < 10; ++i) {
+      values.emplace_back(i);
+    }
+    CHECK(values.capacity() == 12);
+    CHECK(values[9].value == 9);
+    CHECK(Pinned::live == 10);
+  }
+  CHECK(Pinned::live == 0);
+  resource.release();
+}
+
+TEST_SUITE_END();
\ No newline at end of file
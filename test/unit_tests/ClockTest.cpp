@@ -0,0 +1,70 @@
+#include "doctest/doctest.h"
+
+#include <chrono>
+#include <cstdint>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/Clock.h"
+
+TEST_SUITE_BEGIN("Clock");
+
+using namespace clob;
+
+namespace {
+
+timestamp_ns_t system_ns() {
+  return static_cast<timestamp_ns_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+}
+
+} // namespace
+
+/***/
+TEST_CASE("clock_system") {
+  Clock clock;
+  CHECK(clock.get_mode() == ClockMode::System);
+  const timestamp_ns_t before = system_ns();
+  const timestamp_ns_t now = clock.now();
+  CHECK(now >= before);
+  CHECK(now <= system_ns());
+  CHECK_FALSE(clock.set_time(42));
+}
+
+/***/
+TEST_CASE("clock_manual") {
+  Clock clock;
+  REQUIRE(clock.configure(ClockMode::Manual));
+  CHECK(clock.get_mode() == ClockMode::Manual);
+  CHECK(clock.now() == 0);
+  CHECK(clock.set_time(42));
+  CHECK(clock.now() == 42);
+  CHECK(clock.now() == 42);
+  REQUIRE(clock.configure(ClockMode::System));
+  CHECK(clock.now() > 42);
+}
+
+/***/
+TEST_CASE("clock_tsc") {
+  Clock clock;
+  if (!clock.configure(ClockMode::Tsc)) {
+    CHECK(clock.get_mode() == ClockMode::System);
+    return;
+  }
+  CHECK(clock.get_mode() == ClockMode::Tsc);
+  CHECK_FALSE(clock.set_time(42));
+  // Readings are monotonic and within a second of the system clock.
+  timestamp_ns_t last = clock.now();
+  for (int i = 0; i < 1000; ++i) {
+    const timestamp_ns_t now = clock.now();
+    CHECK(now >= last);
+    last = now;
+  }
+  const timestamp_ns_t second = 1000000000;
+  CHECK(last + second > system_ns());
+  CHECK(last < system_ns() + second);
+}
+
+TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <type_traits>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/DenseLadder.h"
+#include "clob/LimitOrder.h"
+
+TEST_SUITE_BEGIN("DenseLadder");
+
+using namespace clob;
+
+/***/
+TEST_CASE("dense_ladder_accepts") {
+  DenseLadder<LimitOrder::OrderType::Bid> ladder{{10000, 5, 100}};
+
+  CHECK(ladder.accepts(10000));
+  CHECK(ladder.accepts(10005));
+  CHECK(ladder.accepts(10495));
+  CHECK_FALSE(ladder.accepts(9995));
+  CHECK_FALSE(ladder.accepts(10003));
+  CHECK_FALSE(ladder.accepts(10500));
+
+  DenseLadder<LimitOrder::OrderType::Bid> empty_ladder;
+  CHECK_FALSE(empty_ladder.accepts(0));
+}
+
+/***/
+TEST_CASE("dense_ladder_bid_ordering") {
+  DenseLadder<LimitOrder::OrderType::Bid> ladder{{10000, 1, 1000}};
+  LimitOrder order1{1, 1000, 10500, 100};
+  LimitOrder order2{2, 2000, 10700, 100};
+  LimitOrder order3{3, 3000, 10500, 100};
+  LimitOrder order4{4, 4000, 10100, 100};
+
+  CHECK(ladder.best_level() == nullptr);
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+  ladder.push(&order4);
+  CHECK(ladder.size() == 4);
+  CHECK(ladder.num_levels() == 3);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 10700);
+
+  ladder.pop();
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 10500);
+  CHECK(ladder.best_level()->front() == &order1);
+  ladder.pop();
+  CHECK(ladder.best_level()->front() == &order3);
+  ladder.pop();
+  CHECK(ladder.best_level()->price == 10100);
+  ladder.pop();
+  CHECK(ladder.empty());
+  CHECK(ladder.num_levels() == 0);
+  CHECK(ladder.best_level() == nullptr);
+}
+
+/***/
+TEST_CASE("dense_ladder_ask_ordering") {
+  DenseLadder<LimitOrder::OrderType::Ask> ladder{{10000, 10, 1000}};
+  LimitOrder order1{1, 1000, 10500, 100};
+  LimitOrder order2{2, 2000, 10300, 100};
+  LimitOrder order3{3, 3000, 19990, 100};
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 10300);
+  ladder.pop();
+  CHECK(ladder.best_level()->price == 10500);
+  ladder.pop();
+  CHECK(ladder.best_level()->price == 19990);
+}
+
+/***/
+TEST_CASE("dense_ladder_erase") {
+  DenseLadder<LimitOrder::OrderType::Ask> ladder{{10000, 1, 1000}};
+  LimitOrder order1{1, 1000, 10300, 100};
+  LimitOrder order2{2, 2000, 10500, 100};
+  LimitOrder order3{3, 3000, 10500, 100};
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+
+  ladder.erase(&order2);
+  CHECK(ladder.num_levels() == 2);
+  ladder.erase(&order1);
+  CHECK(ladder.num_levels() == 1);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->front() == &order3);
+  ladder.erase(&order3);
+  CHECK(ladder.empty());
+  CHECK(ladder.best_level() == nullptr);
+}
+
+TEST_SUITE_END();
\ No newline at end of file
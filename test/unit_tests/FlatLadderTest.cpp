@@ -0,0 +1,116 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/FlatLadder.h"
+#include "clob/LimitOrder.h"
+#include "clob/PriceLevel.h"
+
+TEST_SUITE_BEGIN("FlatLadder");
+
+using namespace clob;
+
+/***/
+TEST_CASE("flat_ladder_bid_ordering") {
+  FlatLadder<LimitOrder::OrderType::Bid> ladder;
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15100, 100};
+  LimitOrder order3{3, 3000, 15000, 100};
+  LimitOrder order4{4, 4000, 14900, 100};
+
+  CHECK(ladder.empty());
+  CHECK(ladder.best_level() == nullptr);
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+  ladder.push(&order4);
+  CHECK(ladder.size() == 4);
+  CHECK(ladder.num_levels() == 3);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 15100);
+
+  ladder.pop();
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->front() == &order1);
+  ladder.pop();
+  CHECK(ladder.best_level()->front() == &order3);
+  ladder.pop();
+  CHECK(ladder.best_level()->front() == &order4);
+  ladder.pop();
+  CHECK(ladder.empty());
+  CHECK(ladder.num_levels() == 0);
+  CHECK(ladder.best_level() == nullptr);
+}
+
+/***/
+TEST_CASE("flat_ladder_ask_ordering") {
+  FlatLadder<LimitOrder::OrderType::Ask> ladder;
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 14900, 100};
+  LimitOrder order3{3, 3000, 15100, 100};
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 14900);
+
+  ladder.pop();
+  CHECK(ladder.best_level()->price == 15000);
+  ladder.pop();
+  CHECK(ladder.best_level()->price == 15100);
+}
+
+/***/
+TEST_CASE("flat_ladder_erase_inside") {
+  FlatLadder<LimitOrder::OrderType::Ask> ladder;
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15100, 100};
+  LimitOrder order3{3, 3000, 15200, 100};
+  LimitOrder order4{4, 4000, 15100, 100};
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+
+  ladder.erase(&order2);
+  CHECK(ladder.num_levels() == 2);
+  CHECK(order2.level == nullptr);
+
+  ladder.erase(&order1);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 15200);
+
+  ladder.push(&order4);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->front() == &order4);
+  ladder.pop();
+  CHECK(ladder.best_level()->front() == &order3);
+  ladder.pop();
+  CHECK(ladder.empty());
+}
+
+/***/
+TEST_CASE("flat_ladder_for_each_level") {
+  FlatLadder<LimitOrder::OrderType::Bid> ladder;
+  std::vector<std::unique_ptr<LimitOrder>> orders;
+  for (price_t price : {15000, 15300, 14800, 15100, 15200}) {
+    orders.push_back(std::make_unique<LimitOrder>(price, price, price, 100));
+    ladder.push(orders.back().get());
+  }
+  ladder.erase(orders[3].get());
+
+  std::vector<price_t> prices;
+  ladder.for_each_level([&](const PriceLevel &level) {
+    prices.push_back(level.price);
+    return prices.size() < 3;
+  });
+  CHECK(prices == std::vector<price_t>{15300, 15200, 15000});
+}
+
+TEST_SUITE_END();
\ No newline at end of file
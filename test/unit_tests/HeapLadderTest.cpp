@@ -0,0 +1,150 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/HeapLadder.h"
+#include "clob/LimitOrder.h"
+#include "clob/PriceLevel.h"
+
+TEST_SUITE_BEGIN("HeapLadder");
+
+using namespace clob;
+
+/***/
+TEST_CASE("heap_ladder_bid_ordering") {
+  HeapLadder<LimitOrder::OrderType::Bid> ladder;
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15100, 100};
+  LimitOrder order3{3, 3000, 15000, 100};
+  LimitOrder order4{4, 4000, 14900, 100};
+
+  CHECK(ladder.empty());
+  CHECK(ladder.best_level() == nullptr);
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+  ladder.push(&order4);
+  CHECK(ladder.size() == 4);
+  CHECK(ladder.num_levels() == 3);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 15100);
+
+  ladder.pop();
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->front() == &order1);
+  ladder.pop();
+  CHECK(ladder.best_level()->front() == &order3);
+  ladder.pop();
+  CHECK(ladder.best_level()->front() == &order4);
+  ladder.pop();
+  CHECK(ladder.empty());
+  CHECK(ladder.num_levels() == 0);
+  CHECK(ladder.best_level() == nullptr);
+}
+
+/***/
+TEST_CASE("heap_ladder_ask_ordering") {
+  HeapLadder<LimitOrder::OrderType::Ask> ladder;
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 14900, 100};
+  LimitOrder order3{3, 3000, 15100, 100};
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 14900);
+
+  ladder.pop();
+  CHECK(ladder.best_level()->price == 15000);
+  ladder.pop();
+  CHECK(ladder.best_level()->price == 15100);
+}
+
+/***/
+TEST_CASE("heap_ladder_erase_skips_stale_levels") {
+  HeapLadder<LimitOrder::OrderType::Ask> ladder;
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15100, 100};
+  LimitOrder order3{3, 3000, 15200, 100};
+  LimitOrder order4{4, 4000, 15100, 100};
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+
+  ladder.erase(&order2);
+  CHECK(ladder.num_levels() == 2);
+  CHECK(order2.level == nullptr);
+
+  ladder.erase(&order1);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 15200);
+
+  ladder.push(&order4);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->front() == &order4);
+  ladder.pop();
+  CHECK(ladder.best_level()->front() == &order3);
+  ladder.pop();
+  CHECK(ladder.empty());
+}
+
+/***/
+TEST_CASE("heap_ladder_for_each_level") {
+  HeapLadder<LimitOrder::OrderType::Bid> ladder;
+  std::vector<std::unique_ptr<LimitOrder>> orders;
+  for (price_t price : {15000, 15300, 14800, 15100, 15200}) {
+    orders.push_back(std::make_unique<LimitOrder>(price, price, price, 100));
+    ladder.push(orders.back().get());
+  }
+  ladder.erase(orders[3].get());
+
+  std::vector<price_t> prices;
+  ladder.for_each_level([&](const PriceLevel &level) {
+    prices.push_back(level.price);
+    return prices.size() < 3;
+  });
+  CHECK(prices == std::vector<price_t>{15300, 15200, 15000});
+}
+
+/***/
+TEST_CASE("heap_ladder_for_each_level_skips_stale_entries") {
+  HeapLadder<LimitOrder::OrderType::Ask> ladder;
+  std::vector<std::unique_ptr<LimitOrder>> orders;
+  for (price_t price = 15000; price < 15020; ++price) {
+    orders.push_back(std::make_unique<LimitOrder>(price, price, price, 100));
+    ladder.push(orders.back().get());
+  }
+  // Releasing and recreating levels leaves stale and duplicate heap entries.
+  ladder.erase(orders[5].get());
+  ladder.erase(orders[12].get());
+  orders.push_back(std::make_unique<LimitOrder>(100, 100, 15005, 100));
+  ladder.push(orders.back().get());
+
+  std::vector<price_t> prices;
+  ladder.for_each_level([&](const PriceLevel &level) {
+    prices.push_back(level.price);
+    return true;
+  });
+  REQUIRE(prices.size() == 19);
+  for (std::size_t i = 1; i < prices.size(); ++i) {
+    CHECK(prices[i - 1] < prices[i]);
+  }
+  CHECK(prices[5] == 15005);
+  CHECK(prices[12] == 15013);
+
+  prices.clear();
+  ladder.for_each_level([&](const PriceLevel &level) {
+    prices.push_back(level.price);
+    return level.price < 15003;
+  });
+  CHECK(prices == std::vector<price_t>{15000, 15001, 15002, 15003});
+}
+
+TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/HugePageArena.h"
+#include "clob/LimitOrder.h"
+#include "clob/OrderBook.h"
+
+TEST_SUITE_BEGIN("HugePageArena");
+
+using namespace clob;
+
+namespace {
+
+bool is_aligned(const void *p, const std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+} // namespace
+
+/***/
+TEST_CASE("huge_page_arena_allocate") {
+  HugePageArena arena;
+  CHECK(arena.num_regions() == 0);
+  CHECK(arena.size() == 0);
+
+  void *small = arena.allocate(24, 8);
+  void *line = arena.allocate(64, 64);
+  void *large = arena.allocate(10000, 64);
+  CHECK(arena.num_regions() == 1);
+  CHECK(is_aligned(small, 8));
+  CHECK(is_aligned(line, 64));
+  CHECK(is_aligned(large, 4096));
+  CHECK(arena.size() == 32 + 64 + 12288);
+
+  arena.deallocate(small, 24);
+  arena.deallocate(large, 10000);
+  CHECK(arena.size() == 64);
+  CHECK(arena.allocate(32, 8) == small);
+  CHECK(arena.allocate(12000, 64) == large);
+  CHECK(arena.allocate(10000, 64) != large);
+}
+
+/***/
+TEST_CASE("huge_page_arena_reuses_large_blocks_of_any_size") {
+  HugePageArena arena{
+      {HugePageMode::Off, std::size_t{2} << 20, std::size_t{2} << 20}};
+
+  // A buffer reallocated at a new size on every call.
+  for (std::size_t i = 1; i <= 200; ++i) {
+    void *block = arena.allocate(i * 4096 + 100, 64);
+    arena.deallocate(block, i * 4096 + 100, 64);
+  }
+  CHECK(arena.num_regions() == 1);
+
+  // Varying sizes with live blocks allocated in between.
+  void *large = arena.allocate(64 * 4096, 64);
+  std::vector<void *> live{arena.allocate(64, 64)};
+  arena.deallocate(large, 64 * 4096, 64);
+  for (std::size_t i = 1; i <= 200; ++i) {
+    const std::size_t bytes = (i * 37 % 64 + 1) * 4096;
+    void *block = arena.allocate(bytes, 64);
+    CHECK(is_aligned(block, 4096));
+    live.push_back(arena.allocate(64, 64));
+    arena.deallocate(block, bytes, 64);
+  }
+  CHECK(arena.num_regions() == 1);
+  CHECK(arena.allocate(64 * 4096, 64) == large);
+}
+
+/***/
+TEST_CASE("huge_page_arena_regions") {
+  HugePageArena arena{{HugePageMode::Off, std::size_t{2} << 20, 1}};
+  CHECK(arena.allocate(4096) != nullptr);
+  CHECK(arena.allocate(std::size_t{3} << 20) != nullptr);
+  CHECK(arena.num_regions() == 2);
+
+  const HugePageStats stats = arena.stats();
+  CHECK(stats.page_size == std::size_t{2} << 20);
+  CHECK(stats.huge_pages == 0);
+  CHECK(stats.transparent_pages == 0);
+  CHECK(stats.normal_pages * 4096 == (std::size_t{2} << 20) * 3);
+}
+
+/***/
+TEST_CASE("huge_page_arena_falls_back") {
+  // Whatever the machine offers, the arena hands out usable memory and
+  // accounts for every page it mapped.
+  for (const HugePageMode mode :
+       {HugePageMode::Transparent, HugePageMode::Explicit}) {
+    HugePageArena arena{{mode, std::size_t{2} << 20, std::size_t{2} << 20}};
+    auto *bytes = static_cast<unsigned char *>(arena.allocate(1 << 20, 64));
+    bytes[0] = 1;
+    bytes[(1 << 20) - 1] = 2;
+    const HugePageStats stats = arena.stats();
+    CHECK(stats.huge_pages * stats.page_size +
+              stats.transparent_pages * stats.page_size +
+              stats.normal_pages * 4096 ==
+          std::size_t{2} << 20);
+  }
+}
+
+/***/
+TEST_CASE("huge_page_arena_configure") {
+  HugePageArena arena;
+  CHECK(arena.configure({HugePageMode::Transparent, std::size_t{1} << 30,
+                         std::size_t{1} << 20}));
+  CHECK(arena.configure({HugePageMode::Off, 3, 0}));
+  CHECK(arena.allocate(8) != nullptr);
+  CHECK(arena.stats().page_size == std::size_t{2} << 20);
+  CHECK_FALSE(arena.configure({}));
+}
+
+/***/
+TEST_CASE("huge_page_allocator_containers") {
+  HugePageArena arena;
+  std::vector<int, HugePageAllocator<int>> values{
+      HugePageAllocator<int>(&arena)};
+  std::map<int, int, std::less<int>,
+           HugePageAllocator<std::pair<const int, int>>>
+      map{HugePageAllocator<std::pair<const int, int>>(&arena)};
+  for (int i = 0; i < 10000; ++i) {
+    values.push_back(i);
+    map.emplace(i, i);
+  }
+  const std::size_t in_use = arena.size();
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 10000; ++i) {
+      map.erase(i);
+    }
+    for (int i = 0; i < 10000; ++i) {
+      map.emplace(i, i);
+    }
+  }
+  CHECK(arena.size() == in_use);
+  CHECK(values[9999] == 9999);
+  CHECK(map.at(5000) == 5000);
+}
+
+/***/
+TEST_CASE("huge_page_order_book") {
+  HugePageArena arena;
+  HugePageOrderBook order_book{{}, HugePageAllocator<PriceLevel>(&arena)};
+  LimitOrder bid{1, 1000, 15000, 100};
+  LimitOrder ask1{2, 2000, 15000, 40};
+  LimitOrder ask2{3, 3000, 15100, 40};
+
+  order_book.add_bid_order(&bid);
+  order_book.add_ask_order(&ask2);
+  CHECK(arena.size() != 0);
+  order_book.add_ask_order(&ask1);
+  CHECK(ask1.filled_quantity == 40);
+  CHECK(bid.filled_quantity == 40);
+  CHECK(order_book.bids_size() == 1);
+  CHECK(order_book.asks_size() == 1);
+}
+
+/***/
+TEST_CASE("huge_page_arena_memory_resource") {
+  HugePageArena arena;
+  {
+    PmrOrderBook order_book{{}, &arena};
+    LimitOrder bid{1, 1000, 15000, 100};
+    LimitOrder ask{2, 2000, 15100, 40};
+    order_book.add_bid_order(&bid);
+    order_book.add_ask_order(&ask);
+    CHECK(arena.size() != 0);
+
+    std::pmr::monotonic_buffer_resource buffer{1024, &arena};
+    std::pmr::vector<int> values{&buffer};
+    values.resize(4096);
+    CHECK(arena.num_regions() == 1);
+    CHECK(arena.is_equal(arena));
+    CHECK_FALSE(arena.is_equal(buffer));
+  }
+  CHECK(arena.size() == 0);
+}
+
+TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/HybridLadder.h"
+#include "clob/LimitOrder.h"
+
+TEST_SUITE_BEGIN("HybridLadder");
+
+using namespace clob;
+
+/***/
+TEST_CASE("hybrid_ladder_accepts") {
+  HybridLadder<LimitOrder::OrderType::Bid> ladder{{5, 64}};
+
+  CHECK(ladder.accepts(0));
+  CHECK(ladder.accepts(10005));
+  CHECK_FALSE(ladder.accepts(10003));
+}
+
+/***/
+TEST_CASE("hybrid_ladder_bid_ordering") {
+  HybridLadder<LimitOrder::OrderType::Bid> ladder{{1, 64}};
+  LimitOrder order1{1, 1000, 10000, 100};
+  LimitOrder order2{2, 2000, 10010, 100};
+  LimitOrder order3{3, 3000, 9000, 100};
+  LimitOrder order4{4, 4000, 10000, 100};
+
+  CHECK(ladder.best_level() == nullptr);
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+  ladder.push(&order4);
+  CHECK(ladder.size() == 4);
+  CHECK(ladder.num_levels() == 3);
+  CHECK(ladder.num_tail_levels() == 1);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 10010);
+
+  ladder.pop();
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->front() == &order1);
+  ladder.pop();
+  CHECK(ladder.best_level()->front() == &order4);
+  ladder.pop();
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 9000);
+  CHECK(ladder.num_tail_levels() == 0);
+  CHECK(ladder.window_min_price() <= 9000);
+  ladder.pop();
+  CHECK(ladder.empty());
+  CHECK(ladder.num_levels() == 0);
+  CHECK(ladder.best_level() == nullptr);
+}
+
+/***/
+TEST_CASE("hybrid_ladder_recenters_on_better_price") {
+  HybridLadder<LimitOrder::OrderType::Ask> ladder{{1, 64}};
+  LimitOrder order1{1, 1000, 10000, 100};
+  LimitOrder order2{2, 2000, 10020, 100};
+  LimitOrder order3{3, 3000, 5000, 100};
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  CHECK(ladder.num_tail_levels() == 0);
+
+  ladder.push(&order3);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 5000);
+  CHECK(ladder.num_tail_levels() == 2);
+  CHECK(ladder.num_levels() == 3);
+  CHECK(order1.level->price == 10000);
+
+  ladder.erase(&order3);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 10000);
+  CHECK(ladder.num_tail_levels() == 0);
+  CHECK(order1.level == ladder.best_level());
+
+  ladder.erase(&order1);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->front() == &order2);
+  ladder.erase(&order2);
+  CHECK(ladder.empty());
+}
+
+/***/
+TEST_CASE("hybrid_ladder_ring_wraps") {
+  HybridLadder<LimitOrder::OrderType::Ask> ladder{{1, 16}};
+  std::vector<std::unique_ptr<LimitOrder>> orders;
+  for (price_t price = 100; price < 140; ++price) {
+    orders.push_back(std::make_unique<LimitOrder>(price, price, price, 1));
+    ladder.push(orders.back().get());
+  }
+  CHECK(ladder.num_levels() == 40);
+
+  for (price_t price = 100; price < 140; ++price) {
+    REQUIRE(ladder.best_level() != nullptr);
+    CHECK(ladder.best_level()->price == price);
+    ladder.pop();
+  }
+  CHECK(ladder.empty());
+}
+
+/***/
+TEST_CASE("hybrid_ladder_window_stays_below_max_price") {
+  constexpr price_t max_price{std::numeric_limits<price_t>::max()};
+  HybridLadder<LimitOrder::OrderType::Ask> asks{{5, 64}};
+  HybridLadder<LimitOrder::OrderType::Bid> bids{{5, 64}};
+  const price_t top = max_price - max_price % 5;
+  std::vector<std::unique_ptr<LimitOrder>> orders;
+  for (price_t i = 0; i < 8; ++i) {
+    const price_t price = top - (7 - i) * 5;
+    orders.push_back(std::make_unique<LimitOrder>(i, i, price, 1));
+    asks.push(orders.back().get());
+    orders.push_back(std::make_unique<LimitOrder>(8 + i, 8 + i, price, 1));
+    bids.push(orders.back().get());
+  }
+  // A far better price moves both windows away, leaving the top in the tail.
+  LimitOrder low_ask{16, 16, 100, 1};
+  LimitOrder high_bid{17, 17, top, 1};
+  asks.push(&low_ask);
+  bids.push(&high_bid);
+  CHECK(asks.num_tail_levels() == 8);
+
+  asks.pop();
+  for (price_t i = 0; i < 8; ++i) {
+    REQUIRE(asks.best_level() != nullptr);
+    CHECK(asks.best_level()->price == top - (7 - i) * 5);
+    asks.pop();
+  }
+  CHECK(asks.empty());
+  CHECK(asks.num_tail_levels() == 0);
+
+  for (price_t i = 0; i < 8; ++i) {
+    REQUIRE(bids.best_level() != nullptr);
+    CHECK(bids.best_level()->price == top - i * 5);
+    while (bids.best_level() != nullptr &&
+           bids.best_level()->price == top - i * 5) {
+      bids.pop();
+    }
+  }
+  CHECK(bids.empty());
+}
+
+/***/
+TEST_CASE("hybrid_ladder_allocates_window_on_first_order") {
+  CountingResource resource;
+
+  constexpr std::size_t window_bytes{4096 * sizeof(PriceLevel *)};
+  HybridLadder<LimitOrder::OrderType::Bid,
+               std::pmr::polymorphic_allocator<PriceLevel>>
+      ladder{{1, 4096}, &resource};
+  CHECK(resource.allocated_bytes < window_bytes);
+
+  LimitOrder order{1, 1000, 10000, 100};
+  ladder.push(&order);
+  CHECK(resource.allocated_bytes >= window_bytes);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 10000);
+  CHECK(ladder.num_tail_levels() == 0);
+}
+
+TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "doctest/doctest.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/LevelBitmap.h"
+
+TEST_SUITE_BEGIN("LevelBitmap");
+
+using namespace clob;
+
+/***/
+TEST_CASE("level_bitmap_empty") {
+  LevelBitmap bitmap{1000};
+
+  CHECK(bitmap.find_first() == LevelBitmap::npos);
+  CHECK(bitmap.find_last() == LevelBitmap::npos);
+  CHECK_FALSE(bitmap.test(0));
+  CHECK_FALSE(bitmap.test(999));
+
+  LevelBitmap zero_bitmap;
+  CHECK(zero_bitmap.find_first() == LevelBitmap::npos);
+  CHECK(zero_bitmap.find_last() == LevelBitmap::npos);
+}
+
+/***/
+TEST_CASE("level_bitmap_set_reset") {
+  LevelBitmap bitmap{1000};
+
+  bitmap.set(500);
+  CHECK(bitmap.test(500));
+  CHECK(bitmap.find_first() == 500);
+  CHECK(bitmap.find_last() == 500);
+
+  bitmap.set(3);
+  bitmap.set(999);
+  CHECK(bitmap.find_first() == 3);
+  CHECK(bitmap.find_last() == 999);
+
+  bitmap.reset(3);
+  CHECK_FALSE(bitmap.test(3));
+  CHECK(bitmap.find_first() == 500);
+  bitmap.reset(999);
+  CHECK(bitmap.find_last() == 500);
+  bitmap.reset(500);
+  CHECK(bitmap.find_first() == LevelBitmap::npos);
+  CHECK(bitmap.find_last() == LevelBitmap::npos);
+}
+
+/***/
+TEST_CASE("level_bitmap_shared_words") {
+  LevelBitmap bitmap{128};
+
+  bitmap.set(64);
+  bitmap.set(65);
+  bitmap.reset(64);
+  CHECK(bitmap.find_first() == 65);
+  CHECK(bitmap.find_last() == 65);
+  bitmap.set(0);
+  bitmap.reset(65);
+  CHECK(bitmap.find_first() == 0);
+  CHECK(bitmap.find_last() == 0);
+}
+
+/***/
+TEST_CASE("level_bitmap_spans_multiple_top_words") {
+  const std::size_t size = std::size_t{1} << 20;
+  LevelBitmap bitmap{size};
+
+  bitmap.set(10);
+  bitmap.set(size - 1);
+  bitmap.set(300000);
+  CHECK(bitmap.find_first() == 10);
+  CHECK(bitmap.find_last() == size - 1);
+  bitmap.reset(10);
+  bitmap.reset(size - 1);
+  CHECK(bitmap.find_first() == 300000);
+  CHECK(bitmap.find_last() == 300000);
+}
+
+/***/
+TEST_CASE("level_bitmap_find_next_prev") {
+  const std::size_t size = std::size_t{1} << 20;
+  LevelBitmap bitmap{size};
+
+  CHECK(bitmap.size() == size);
+  CHECK(bitmap.find_next(0) == LevelBitmap::npos);
+  CHECK(bitmap.find_prev(size) == LevelBitmap::npos);
+
+  bitmap.set(5);
+  bitmap.set(63);
+  bitmap.set(64);
+  bitmap.set(5000);
+  bitmap.set(400000);
+
+  CHECK(bitmap.find_next(0) == 5);
+  CHECK(bitmap.find_next(5) == 5);
+  CHECK(bitmap.find_next(6) == 63);
+  CHECK(bitmap.find_next(64) == 64);
+  CHECK(bitmap.find_next(65) == 5000);
+  CHECK(bitmap.find_next(5001) == 400000);
+  CHECK(bitmap.find_next(400001) == LevelBitmap::npos);
+  CHECK(bitmap.find_next(size) == LevelBitmap::npos);
+
+  CHECK(bitmap.find_prev(size) == 400000);
+  CHECK(bitmap.find_prev(399999) == 5000);
+  CHECK(bitmap.find_prev(4999) == 64);
+  CHECK(bitmap.find_prev(64) == 64);
+  CHECK(bitmap.find_prev(63) == 63);
+  CHECK(bitmap.find_prev(62) == 5);
+  CHECK(bitmap.find_prev(4) == LevelBitmap::npos);
+}
+
+TEST_SUITE_END();
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "doctest/doctest.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 #include <utility>
@@ -16,25 +17,28 @@ using namespace clob;
 TEST_CASE("limit_order_construction") {
   LimitOrder order1{1, 1000, 15000, 100};
   LimitOrder::id_t order2_id = 2;
-  timestamp_ns_t order2_timestamp = 2000;
+  sequence_t order2_sequence = 2000;
   price_t order2_price = 16000;
   quantity_t order2_quantity = 200;
-  LimitOrder order2{order2_id, order2_timestamp, order2_price, order2_quantity};
+  LimitOrder order2{order2_id, order2_sequence, order2_price, order2_quantity};
 
   CHECK(order1.id == 1);
-  CHECK(order1.timestamp == 1000);
+  CHECK(order1.sequence == 1000);
   CHECK(order1.price == 15000);
   CHECK(order1.balance == 0);
   CHECK(order1.quantity == 100);
   CHECK(order1.filled_quantity == 0);
   CHECK(order1.is_cancelled == false);
   CHECK(order2.id == order2_id);
-  CHECK(order2.timestamp == order2_timestamp);
+  CHECK(order2.sequence == order2_sequence);
   CHECK(order2.price == order2_price);
   CHECK(order2.balance == 0);
   CHECK(order2.quantity == order2_quantity);
   CHECK(order2.filled_quantity == 0);
   CHECK(order2.is_cancelled == false);
+  CHECK(order1.prev == nullptr);
+  CHECK(order1.next == nullptr);
+  CHECK(order1.level == nullptr);
 }
 
 /***/
@@ -42,25 +46,36 @@ TEST_CASE("limit_order_types") {
   LimitOrder order{1, 1000, 15000, 100};
 
   REQUIRE(order.id == 1);
-  REQUIRE(order.timestamp == 1000);
+  REQUIRE(order.sequence == 1000);
   REQUIRE(order.price == 15000);
   REQUIRE(order.quantity == 100);
   REQUIRE(order.filled_quantity == 0);
   REQUIRE(order.is_cancelled == false);
   CHECK(std::is_same_v<decltype(order.id), LimitOrder::id_t>);
-  CHECK(std::is_same_v<decltype(order.timestamp), timestamp_ns_t>);
+  CHECK(std::is_same_v<decltype(order.sequence), sequence_t>);
   CHECK(std::is_same_v<decltype(order.price), price_t>);
   CHECK(std::is_same_v<decltype(order.quantity), quantity_t>);
   CHECK(std::is_same_v<decltype(order.filled_quantity), quantity_t>);
   CHECK(std::is_same_v<decltype(order.is_cancelled), bool>);
   CHECK(sizeof(order.id) >= sizeof(uint_fast64_t));
-  CHECK(sizeof(order.timestamp) >= sizeof(uint_fast64_t));
-  CHECK(sizeof(order.price) >= sizeof(uint_fast32_t));
-  CHECK(sizeof(order.quantity) >= sizeof(uint_fast32_t));
-  CHECK(sizeof(order.filled_quantity) >= sizeof(uint_fast32_t));
+  CHECK(sizeof(order.sequence) >= sizeof(uint_fast64_t));
+  CHECK(sizeof(order.price) == sizeof(uint32_t));
+  CHECK(sizeof(order.quantity) == sizeof(uint32_t));
+  CHECK(sizeof(order.filled_quantity) == sizeof(uint32_t));
   CHECK(sizeof(order.is_cancelled) == sizeof(bool));
 }
 
+/***/
+TEST_CASE("limit_order_layout") {
+  CHECK(alignof(LimitOrder) == cache_line_size);
+  CHECK(sizeof(LimitOrder) == cache_line_size);
+  CHECK(std::is_standard_layout_v<LimitOrder>);
+  CHECK(offsetof(LimitOrder, next) < 32);
+  CHECK(offsetof(LimitOrder, quantity) < 32);
+  CHECK(offsetof(LimitOrder, filled_quantity) < 32);
+  CHECK(offsetof(LimitOrder, is_cancelled) < 32);
+}
+
 /***/
 TEST_CASE("limit_order_order_type_enum") {
   CHECK(static_cast<int>(LimitOrder::OrderType::Bid) == 0);
@@ -104,18 +119,18 @@ TEST_CASE("limit_order_priority_queue_ask_comparator") {
 TEST_CASE("limit_order_edge_cases") {
   LimitOrder zero_order{0, 0, 0, 0};
   CHECK(zero_order.id == 0);
-  CHECK(zero_order.timestamp == 0);
+  CHECK(zero_order.sequence == 0);
   CHECK(zero_order.price == 0);
   CHECK(zero_order.quantity == 0);
   CHECK(zero_order.filled_quantity == 0);
   CHECK(zero_order.is_cancelled == false);
 
-  LimitOrder max_order{UINT_FAST64_MAX, UINT_FAST64_MAX, UINT_FAST32_MAX,
-                       UINT_FAST32_MAX};
+  LimitOrder max_order{UINT_FAST64_MAX, UINT_FAST64_MAX, UINT32_MAX,
+                       UINT32_MAX};
   CHECK(max_order.id == UINT_FAST64_MAX);
-  CHECK(max_order.timestamp == UINT_FAST64_MAX);
-  CHECK(max_order.price == UINT_FAST32_MAX);
-  CHECK(max_order.quantity == UINT_FAST32_MAX);
+  CHECK(max_order.sequence == UINT_FAST64_MAX);
+  CHECK(max_order.price == UINT32_MAX);
+  CHECK(max_order.quantity == UINT32_MAX);
   CHECK(max_order.filled_quantity == 0);
   CHECK(max_order.is_cancelled == false);
 }
@@ -127,7 +142,7 @@ TEST_CASE("limit_order_copy_constructors") {
   LimitOrder order2{order1};
 
   CHECK(order2.id == order1.id);
-  CHECK(order2.timestamp == order1.timestamp);
+  CHECK(order2.sequence == order1.sequence);
   CHECK(order2.price == order1.price);
   CHECK(order2.quantity == order1.quantity);
   CHECK(order2.filled_quantity == order1.filled_quantity);
@@ -141,7 +156,7 @@ TEST_CASE("limit_order_move_constructor") {
   LimitOrder order2{std::move(order1)};
 
   CHECK(order2.id == 1);
-  CHECK(order2.timestamp == 1000);
+  CHECK(order2.sequence == 1000);
   CHECK(order2.price == 15000);
   CHECK(order2.quantity == 100);
   CHECK(order2.filled_quantity == 0);
@@ -1,12 +1,20 @@
 #include "doctest/doctest.h"
 
 #include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include "misc/TestUtilities.h"
 
 #include "clob/LimitOrder.h"
 #include "clob/Market.h"
+#include "clob/OrderStore.h"
+#include "clob/ReferenceFile.h"
 
 TEST_SUITE_BEGIN("Market");
 
@@ -61,8 +69,58 @@ TEST_CASE("market_add_stock") {
   std::string stock6_ticker = "NVDA";
   CHECK(market.add_stock(stock6_name, stock6_ticker));
   CHECK(market.get_num_stocks() == 5);
+  CHECK_FALSE(market.add_stock("stock7", stock6_ticker));
+  CHECK(market.get_num_stocks() == 5);
+  stock6_ticker = "AMD";
   CHECK(market.add_stock(std::move(stock6_name), std::move(stock6_ticker)));
   CHECK(market.get_num_stocks() == 6);
+  CHECK_FALSE(market.add_stock("stock8", ""));
+  CHECK_FALSE(market.add_stock("stock8", "TOOLONGTK"));
+  CHECK(market.get_num_stocks() == 6);
+}
+
+/***/
+TEST_CASE("market_stores_stock_strings") {
+  Market market{"nyse", "NYSE"};
+  {
+    std::string name{"Alphabet Inc. Class A Common Stock"};
+    std::string ticker{"GOOGL"};
+    market.add_stock(name, ticker);
+    market.add_stock(std::move(name), "GOOG");
+  }
+  const Stock *class_a = market.find_stock("GOOGL");
+  const Stock *class_c = market.find_stock("GOOG");
+  REQUIRE(class_a != nullptr);
+  REQUIRE(class_c != nullptr);
+  CHECK(class_a->name == "Alphabet Inc. Class A Common Stock");
+  CHECK(class_a->ticker == "GOOGL");
+  CHECK(class_a->ticker.data() ==
+        class_a->name.data() + class_a->name.size());
+  CHECK(class_c->name == class_a->name);
+  CHECK(class_a->ticker_code == TickerIndex::pack("GOOGL"));
+  CHECK(market.get_exchange_name().data() ==
+        market.get_exchange_name().data());
+}
+
+/***/
+TEST_CASE("market_find_stock") {
+  Market market{"nyse", "NYSE"};
+  market.add_stock("Apple", "AAPL");
+  market.add_stock("Alphabet", "GOOGL");
+  CHECK(market.find_stock("MSFT") == nullptr);
+  REQUIRE(market.find_stock("GOOGL") != nullptr);
+  CHECK(market.find_stock("GOOGL")->id == 1);
+
+  CHECK(market.freeze_stocks());
+  CHECK_FALSE(market.add_stock("Microsoft", "MSFT"));
+  CHECK(market.get_num_stocks() == 2);
+  const Stock *apple = market.find_stock(TickerIndex::pack("AAPL"));
+  REQUIRE(apple != nullptr);
+  CHECK(apple->name == "Apple");
+  CHECK(apple->id == 0);
+  CHECK(market.find_stock("GOOGL")->ticker == "GOOGL");
+  CHECK(market.find_stock("MSFT") == nullptr);
+  CHECK(market.find_stock("") == nullptr);
 }
 
 /***/
@@ -106,6 +164,92 @@ TEST_CASE("market_add_invalid_order") {
   CHECK(market.query_order(5)->is_cancelled == true);
 }
 
+/***/
+TEST_CASE("market_add_market_order") {
+  Market market{"nyse", "NYSE"};
+  market.add_stock("stock1", "AAPL");
+  market.add_order<LimitOrder::OrderType::Ask>(0, 100, 10);
+  market.add_order<LimitOrder::OrderType::Ask>(0, 105, 10);
+  market.add_order<LimitOrder::OrderType::Ask>(0, 120, 10);
+
+  const auto id = market.add_market_order<LimitOrder::OrderType::Bid>(0, 15);
+  CHECK(market.query_order(id)->filled_quantity == 15);
+  CHECK(market.query_order(id)->price == 0);
+  CHECK_FALSE(market.cancel_order(id));
+
+  const auto banded =
+      market.add_market_order<LimitOrder::OrderType::Bid>(0, 15, 10);
+  CHECK(market.query_order(banded)->price == 115);
+  CHECK(market.query_order(banded)->filled_quantity == 5);
+  CHECK(market.query_order(banded)->is_cancelled);
+  CHECK(market.get_order_book(0)->bids_size() == 0);
+  CHECK(market.get_order_book(0)->get_best_ask_order()->price == 120);
+
+  const auto rest = market.add_market_order<LimitOrder::OrderType::Bid>(0, 20);
+  CHECK(market.query_order(rest)->filled_quantity == 10);
+  CHECK(market.query_order(rest)->is_cancelled);
+  CHECK(market.get_traded_volume(0) == 30);
+
+  const auto unknown =
+      market.add_market_order<LimitOrder::OrderType::Ask>(1, 10);
+  CHECK(market.query_order(unknown)->is_cancelled);
+}
+
+/***/
+TEST_CASE("market_time_in_force") {
+  using TimeInForce = LimitOrder::TimeInForce;
+  Market market{"nyse", "NYSE"};
+  market.add_stock("stock1", "AAPL");
+  market.add_order<LimitOrder::OrderType::Ask>(0, 100, 10);
+  market.add_order<LimitOrder::OrderType::Ask>(0, 101, 10);
+
+  const auto fok =
+      market.add_order<LimitOrder::OrderType::Bid, TimeInForce::Fok>(0, 100,
+                                                                     15);
+  CHECK(market.query_order(fok)->is_cancelled);
+  CHECK(market.query_order(fok)->filled_quantity == 0);
+  CHECK(market.get_traded_volume(0) == 0);
+
+  const auto ioc =
+      market.add_order<LimitOrder::OrderType::Bid, TimeInForce::Ioc>(0, 100,
+                                                                     15);
+  CHECK(market.query_order(ioc)->is_cancelled);
+  CHECK(market.query_order(ioc)->filled_quantity == 10);
+  CHECK(market.get_order_book(0)->bids_size() == 0);
+  CHECK_FALSE(market.cancel_order(ioc));
+
+  const auto filled =
+      market.add_order<LimitOrder::OrderType::Bid, TimeInForce::Fok>(0, 101,
+                                                                     10);
+  CHECK(market.query_order(filled)->filled_quantity == 10);
+  CHECK_FALSE(market.query_order(filled)->is_cancelled);
+  CHECK(market.get_traded_volume(0) == 20);
+}
+
+/***/
+TEST_CASE("market_add_post_only_order") {
+  using PostOnly = LimitOrder::PostOnly;
+  Market market{"nyse", "NYSE"};
+  market.add_stock("stock1", "AAPL");
+  market.add_order<LimitOrder::OrderType::Ask>(0, 100, 10);
+
+  const auto rejected = market.add_post_only_order<LimitOrder::OrderType::Bid>(
+      0, 100, 10, PostOnly::Reject);
+  CHECK(market.query_order(rejected)->is_cancelled);
+  CHECK_FALSE(market.cancel_order(rejected));
+
+  const auto slid = market.add_post_only_order<LimitOrder::OrderType::Bid>(
+      0, 105, 10, PostOnly::Slide);
+  CHECK(market.query_order(slid)->price == 99);
+  CHECK(market.query_order(slid)->filled_quantity == 0);
+  CHECK(market.get_order_book(0)->get_best_bid_order()->price == 99);
+  CHECK(market.get_traded_volume(0) == 0);
+
+  const auto unknown = market.add_post_only_order<LimitOrder::OrderType::Ask>(
+      1, 100, 10, PostOnly::Slide);
+  CHECK(market.query_order(unknown)->is_cancelled);
+}
+
 /***/
 TEST_CASE("market_cancel_order") {
   Market market{"nyse", "NYSE"};
@@ -159,4 +303,525 @@ TEST_CASE("market_get_order_book") {
   CHECK(order_book->get_best_ask_order() == nullptr);
 }
 
+/***/
+TEST_CASE("market_cancel_order_removes_from_book") {
+  Market market{"nyse", "NYSE"};
+  market.add_stock("stock1", "AAPL");
+  market.add_stock("stock2", "GOOG");
+  CHECK(market.add_order<LimitOrder::OrderType::Bid>(0, 100, 100) == 0);
+  CHECK(market.add_order<LimitOrder::OrderType::Bid>(0, 101, 100) == 1);
+  CHECK(market.add_order<LimitOrder::OrderType::Ask>(1, 105, 100) == 2);
+  auto order_book = market.get_order_book(0);
+  REQUIRE(order_book->bids_size() == 2);
+
+  CHECK(market.cancel_order(1));
+  CHECK(order_book->bids_size() == 1);
+  REQUIRE(order_book->get_best_bid_order() != nullptr);
+  CHECK(order_book->get_best_bid_order()->id == 0);
+
+  CHECK(market.cancel_order(2));
+  CHECK(market.get_order_book(1)->asks_size() == 0);
+  CHECK(market.get_order_book(1)->get_best_ask_order() == nullptr);
+
+  CHECK(market.add_order<LimitOrder::OrderType::Ask>(0, 100, 50) == 3);
+  CHECK(market.query_order(0)->filled_quantity == 50);
+  CHECK(market.query_order(1)->filled_quantity == 0);
+  CHECK(market.cancel_order(0));
+  CHECK(order_book->bids_size() == 0);
+}
+
+/***/
+TEST_CASE("market_modify_order") {
+  Market market{"nyse", "NYSE"};
+  market.add_stock("stock1", "AAPL");
+  CHECK(market.modify_order(0, 100, 100) == false);
+  CHECK(market.add_order<LimitOrder::OrderType::Bid>(0, 100, 100) == 0);
+  CHECK(market.add_order<LimitOrder::OrderType::Bid>(0, 100, 100) == 1);
+  auto order_book = market.get_order_book(0);
+
+  CHECK(market.modify_order(0, 100, 50));
+  CHECK(market.query_order(0)->quantity == 50);
+  CHECK(order_book->get_best_bid_order()->id == 0);
+
+  CHECK(market.modify_order(0, 101, 50));
+  CHECK(market.query_order(0)->price == 101);
+  CHECK(order_book->bids_size() == 2);
+  CHECK(order_book->get_best_bid_order()->id == 0);
+
+  CHECK(market.add_order<LimitOrder::OrderType::Ask>(0, 102, 30) == 2);
+  CHECK(market.modify_order(2, 101, 30));
+  CHECK(market.query_order(2)->filled_quantity == 30);
+  CHECK(market.query_order(0)->filled_quantity == 30);
+  CHECK(market.modify_order(2, 101, 40) == false);
+
+  CHECK(market.modify_order(0, 101, 30));
+  CHECK(market.query_order(0)->is_cancelled);
+  CHECK(market.modify_order(0, 101, 100) == false);
+  CHECK(order_book->bids_size() == 1);
+}
+
+/***/
+TEST_CASE("market_cancel_all_orders") {
+  Market market{"nyse", "NYSE"};
+  market.add_stock("stock1", "AAPL");
+  market.add_stock("stock2", "GOOG");
+  CHECK(market.cancel_all_orders(0) == 0);
+  market.add_order<LimitOrder::OrderType::Bid>(0, 100, 100);
+  market.add_order<LimitOrder::OrderType::Ask>(1, 105, 100);
+  market.add_order<LimitOrder::OrderType::Ask>(0, 102, 100);
+  market.add_order<LimitOrder::OrderType::Bid>(0, 99, 100);
+  market.add_order<LimitOrder::OrderType::Bid>(0, 98, 100);
+  CHECK(market.cancel_order(4));
+
+  CHECK(market.cancel_all_orders(0) == 3);
+  CHECK(market.get_order_book(0)->bids_size() == 0);
+  CHECK(market.get_order_book(0)->asks_size() == 0);
+  CHECK(market.query_order(0)->is_cancelled);
+  CHECK(market.query_order(2)->is_cancelled);
+  CHECK(market.get_order_book(1)->asks_size() == 1);
+  CHECK_FALSE(market.query_order(1)->is_cancelled);
+  CHECK(market.cancel_all_orders(0) == 0);
+  CHECK(market.cancel_all_orders(2) == 0);
+}
+
+/***/
+TEST_CASE("market_get_traded_volume") {
+  Market market{"nyse", "NYSE"};
+  market.add_stock("stock1", "AAPL");
+  market.add_stock("stock2", "GOOG");
+  CHECK(market.get_traded_volume(0) == 0);
+  market.add_order<LimitOrder::OrderType::Bid>(0, 100, 100);
+  market.add_order<LimitOrder::OrderType::Bid>(0, 101, 100);
+  market.add_order<LimitOrder::OrderType::Ask>(1, 100, 70);
+  market.add_order<LimitOrder::OrderType::Ask>(0, 100, 150);
+  market.add_order<LimitOrder::OrderType::Bid>(1, 100, 20);
+
+  CHECK(market.get_traded_volume(0) == 150);
+  CHECK(market.get_traded_volume(1) == 20);
+  CHECK(market.get_traded_volume(2) == 0);
+
+  // A re-queued order that crosses trades like a new one.
+  market.add_order<LimitOrder::OrderType::Ask>(0, 102, 80);
+  CHECK(market.modify_order(0, 102, 100));
+  CHECK(market.get_traded_volume(0) == 200);
+  CHECK_FALSE(market.cancel_order(0));
+  CHECK(market.query_order(5)->filled_quantity == 50);
+}
+
+/***/
+TEST_CASE("market_archive_terminal_orders") {
+  constexpr std::size_t chunk_size{OrderStore::chunk_size};
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "clob_market_archive_test.bin")
+          .string();
+  {
+    Market market{"nyse", "NYSE"};
+    market.add_stock("stock1", "AAPL");
+    CHECK(market.archive_terminal_orders() == 0);
+    REQUIRE(market.set_retention_policy(path, 0));
+
+    // The first chunk only holds orders that trade with each other.
+    for (std::size_t i = 0; i < chunk_size / 2; ++i) {
+      market.add_order<LimitOrder::OrderType::Bid>(0, 100, 10);
+      market.add_order<LimitOrder::OrderType::Ask>(0, 100, 10);
+    }
+    CHECK(market.get_num_order_chunks() == 1);
+
+    // Starting the second chunk retires the first.
+    const LimitOrder::id_t resting1 =
+        market.add_order<LimitOrder::OrderType::Bid>(0, 99, 10);
+    CHECK(market.get_num_order_chunks() == 1);
+    CHECK(market.get_num_archived_orders() == chunk_size);
+    for (std::size_t i = 1; i < chunk_size / 2; ++i) {
+      market.add_order<LimitOrder::OrderType::Bid>(0, 100, 10);
+      market.add_order<LimitOrder::OrderType::Ask>(0, 100, 10);
+    }
+    const LimitOrder::id_t resting2 =
+        market.add_order<LimitOrder::OrderType::Bid>(0, 98, 10);
+
+    // The second chunk still has resting orders and stays in memory.
+    market.add_order<LimitOrder::OrderType::Ask>(0, 200, 10);
+    CHECK(market.get_num_order_chunks() == 2);
+    CHECK(market.get_num_archived_orders() == chunk_size);
+
+    CHECK(market.query_order(1) == nullptr);
+    ArchivedOrder order;
+    REQUIRE(market.query_archived_order(1, order));
+    CHECK(order.id == 1);
+    CHECK(order.price == 100);
+    CHECK(order.filled_quantity == 10);
+    CHECK(order.balance == 1000);
+    CHECK(order.stock_id == 0);
+    CHECK(order.order_type == LimitOrder::OrderType::Ask);
+    CHECK_FALSE(market.query_archived_order(resting1, order));
+    CHECK_FALSE(market.cancel_order(1));
+    CHECK_FALSE(market.modify_order(1, 100, 20));
+    CHECK(market.query_order(resting1)->level != nullptr);
+    CHECK(market.get_traded_volume(0) == (chunk_size - 1) * 10);
+
+    CHECK(market.cancel_order(resting1));
+    CHECK(market.cancel_order(resting2));
+    CHECK(market.archive_terminal_orders() == chunk_size);
+    CHECK(market.archive_terminal_orders() == 0);
+    CHECK(market.get_num_order_chunks() == 1);
+    REQUIRE(market.query_archived_order(resting2, order));
+    CHECK(order.is_cancelled);
+    CHECK(order.price == 98);
+    CHECK(market.get_traded_volume(0) == (chunk_size - 1) * 10);
+    CHECK(market.query_order(3 * chunk_size) == nullptr);
+    CHECK_FALSE(market.query_archived_order(3 * chunk_size, order));
+  }
+  std::filesystem::remove(path);
+}
+
+/***/
+TEST_CASE("market_archive_delay") {
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "clob_market_delay_test.bin")
+          .string();
+  {
+    Market market{"nyse", "NYSE"};
+    market.add_stock("stock1", "AAPL");
+    REQUIRE(market.set_retention_policy(path, timestamp_ns_t{3600} *
+                                                  1000000000));
+    for (std::size_t i = 0; i <= OrderStore::chunk_size; ++i) {
+      market.add_order<LimitOrder::OrderType::Bid>(1, 100, 10);
+    }
+    CHECK(market.query_order(0)->is_cancelled);
+    CHECK(market.archive_terminal_orders() == 0);
+    CHECK(market.get_num_order_chunks() == 2);
+  }
+  std::filesystem::remove(path);
+}
+
+/***/
+TEST_CASE("market_manual_clock") {
+  const auto replay = [](Market &market) {
+    market.add_stock("stock1", "AAPL");
+    REQUIRE(market.set_clock(ClockMode::Manual));
+    for (timestamp_ns_t t = 0; t < 100; ++t) {
+      REQUIRE(market.set_time(1000 + t / 4));
+      const auto price = static_cast<price_t>(95 + t * 7 % 11);
+      if (t % 3 == 0) {
+        market.add_order<LimitOrder::OrderType::Ask>(0, price, 10);
+      } else {
+        market.add_order<LimitOrder::OrderType::Bid>(0, price, 7);
+      }
+      if (t % 5 == 4) {
+        market.modify_order(static_cast<LimitOrder::id_t>(t - 2), price, 20);
+      }
+    }
+  };
+  Market market1{"nyse", "NYSE"};
+  Market market2{"nyse", "NYSE"};
+  replay(market1);
+  replay(market2);
+  CHECK(market1.get_time() == 1024);
+  timestamp_ns_t timestamp{0};
+  REQUIRE(market1.get_order_timestamp(5, timestamp));
+  CHECK(timestamp == 1001);
+  CHECK(market1.get_traded_volume(0) == market2.get_traded_volume(0));
+  for (LimitOrder::id_t id = 0; id < 100; ++id) {
+    const LimitOrder *order1 = market1.query_order(id);
+    const LimitOrder *order2 = market2.query_order(id);
+    timestamp_ns_t timestamp1{0};
+    timestamp_ns_t timestamp2{0};
+    REQUIRE(market1.get_order_timestamp(id, timestamp1));
+    REQUIRE(market2.get_order_timestamp(id, timestamp2));
+    CHECK(timestamp1 == timestamp2);
+    CHECK(order1->sequence == order2->sequence);
+    CHECK(order1->price == order2->price);
+    CHECK(order1->filled_quantity == order2->filled_quantity);
+    CHECK(order1->is_cancelled == order2->is_cancelled);
+  }
+
+  Market system{"nyse", "NYSE"};
+  CHECK_FALSE(system.set_time(1000));
+  CHECK(system.get_time() > 1000);
+}
+
+/***/
+TEST_CASE("market_sequence_numbers") {
+  Market market{"nyse", "NYSE"};
+  market.add_stock("stock1", "AAPL");
+  market.add_stock("stock2", "GOOG");
+  REQUIRE(market.set_clock(ClockMode::Manual));
+  REQUIRE(market.set_time(500));
+  market.add_order<LimitOrder::OrderType::Bid>(0, 100, 10);
+  market.add_order<LimitOrder::OrderType::Bid>(1, 100, 10);
+  market.add_order<LimitOrder::OrderType::Bid>(0, 100, 10);
+  CHECK(market.query_order(0)->sequence < market.query_order(1)->sequence);
+  CHECK(market.query_order(1)->sequence < market.query_order(2)->sequence);
+
+  // The clock steps back, priority still follows acceptance.
+  REQUIRE(market.set_time(100));
+  market.add_order<LimitOrder::OrderType::Bid>(0, 100, 10);
+  market.add_order<LimitOrder::OrderType::Ask>(0, 100, 25);
+  CHECK(market.query_order(0)->filled_quantity == 10);
+  CHECK(market.query_order(2)->filled_quantity == 10);
+  CHECK(market.query_order(3)->filled_quantity == 5);
+
+  // Re-queueing takes a new sequence number and timestamp.
+  REQUIRE(market.set_time(900));
+  const sequence_t sequence = market.query_order(3)->sequence;
+  CHECK(market.modify_order(3, 100, 8));
+  CHECK(market.query_order(3)->sequence == sequence);
+  CHECK(market.modify_order(3, 99, 8));
+  CHECK(market.query_order(3)->sequence > sequence);
+  timestamp_ns_t timestamp{0};
+  REQUIRE(market.get_order_timestamp(3, timestamp));
+  CHECK(timestamp == 900);
+  REQUIRE(market.get_order_timestamp(2, timestamp));
+  CHECK(timestamp == 500);
+  CHECK_FALSE(market.get_order_timestamp(5, timestamp));
+}
+
+/***/
+TEST_CASE("market_archive_manual_clock") {
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "clob_market_clock_test.bin")
+          .string();
+  {
+    Market market{"nyse", "NYSE"};
+    market.add_stock("stock1", "AAPL");
+    REQUIRE(market.set_clock(ClockMode::Manual));
+    REQUIRE(market.set_retention_policy(path, 100));
+    for (std::size_t i = 0; i < OrderStore::chunk_size; ++i) {
+      market.add_order<LimitOrder::OrderType::Bid>(1, 100, 10);
+    }
+    CHECK(market.archive_terminal_orders() == 0);
+    REQUIRE(market.set_time(100));
+    CHECK(market.archive_terminal_orders() == OrderStore::chunk_size);
+
+    // The delay runs from the time the last order became terminal.
+    market.add_stock("stock2", "MSFT");
+    const LimitOrder::id_t resting =
+        market.add_order<LimitOrder::OrderType::Bid>(1, 100, 10);
+    for (std::size_t i = 1; i < OrderStore::chunk_size; ++i) {
+      market.add_order<LimitOrder::OrderType::Bid>(2, 100, 10);
+    }
+    REQUIRE(market.set_time(1000));
+    CHECK(market.cancel_order(resting));
+    REQUIRE(market.set_time(1099));
+    CHECK(market.archive_terminal_orders() == 0);
+    REQUIRE(market.set_time(1100));
+    CHECK(market.archive_terminal_orders() == OrderStore::chunk_size);
+  }
+  std::filesystem::remove(path);
+}
+
+/***/
+TEST_CASE("market_order_capacity") {
+  constexpr LimitOrder::id_t generation{LimitOrder::id_t{1} << 32};
+  Market market{"nyse", "NYSE"};
+  market.add_stock("stock1", "AAPL");
+  REQUIRE(market.set_order_capacity(4));
+  CHECK(market.add_order<LimitOrder::OrderType::Bid>(0, 100, 10) == 0);
+  CHECK(market.add_order<LimitOrder::OrderType::Ask>(0, 100, 10) == 1);
+  CHECK(market.add_order<LimitOrder::OrderType::Bid>(0, 99, 10) == 2);
+  CHECK(market.add_order<LimitOrder::OrderType::Ask>(0, 101, 10) == 3);
+  CHECK_FALSE(market.set_order_capacity(8));
+  CHECK_FALSE(market.set_retention_policy("unused.bin", 0));
+
+  // The table is full, the filled orders give up their slots.
+  const LimitOrder::id_t id4 =
+      market.add_order<LimitOrder::OrderType::Bid>(0, 98, 10);
+  const LimitOrder::id_t id5 =
+      market.add_order<LimitOrder::OrderType::Ask>(0, 102, 10);
+  CHECK(id4 == generation);
+  CHECK(id5 == generation + 1);
+  CHECK(market.query_order(0) == nullptr);
+  CHECK(market.query_order(1) == nullptr);
+  CHECK_FALSE(market.cancel_order(0));
+  CHECK_FALSE(market.modify_order(1, 102, 5));
+  REQUIRE(market.query_order(id4) != nullptr);
+  CHECK(market.query_order(id4)->id == id4);
+  CHECK(market.query_order(id4)->price == 98);
+  CHECK(market.get_order_book(0)->bids_size() == 2);
+  CHECK(market.get_traded_volume(0) == 10);
+
+  // A cancelled order's slot is reused as well, the stale id stays dead.
+  CHECK(market.cancel_order(2));
+  CHECK(market.add_order<LimitOrder::OrderType::Bid>(0, 97, 10) ==
+        generation + 2);
+  CHECK_FALSE(market.cancel_order(2));
+  CHECK(market.cancel_order(generation + 2));
+  CHECK(market.add_order<LimitOrder::OrderType::Bid>(0, 96, 10) ==
+        2 * generation + 2);
+
+  // With every order live the table grows instead.
+  CHECK(market.add_order<LimitOrder::OrderType::Bid>(0, 95, 10) == 4);
+  CHECK(market.get_order_book(0)->bids_size() == 3);
+}
+
+/***/
+TEST_CASE("market_reserve") {
+  Market market{"nyse", "NYSE"};
+  market.reserve(200, 3 * OrderStore::chunk_size);
+  CHECK(market.get_num_order_chunks() == 0);
+
+  market.add_stock("stock0", "S0");
+  const OrderBook *first_book = market.get_order_book(0);
+  const LimitOrder *first_order = market.query_order(
+      market.add_order<LimitOrder::OrderType::Bid>(0, 100, 10));
+  for (std::size_t i = 1; i < 200; ++i) {
+    market.add_stock("stock", "S" + std::to_string(i));
+  }
+  for (std::size_t i = 1; i < 3 * OrderStore::chunk_size; ++i) {
+    market.add_order<LimitOrder::OrderType::Bid>(i % 200, 100, 10);
+  }
+  CHECK(market.get_num_order_chunks() == 3);
+  CHECK(market.get_order_book(0) == first_book);
+  CHECK(market.query_order(0) == first_order);
+  CHECK(first_book->get_best_bid_order() == first_order);
+  CHECK(market.get_order_book(199)->bids_size() != 0);
+}
+
+/***/
+TEST_CASE("market_huge_pages") {
+  Market market{"nyse", "NYSE"};
+  CHECK(market.set_huge_pages({HugePageMode::Explicit}));
+  market.add_stock("stock1", "AAPL");
+  market.add_order<LimitOrder::OrderType::Bid>(0, 100, 10);
+  CHECK_FALSE(market.set_huge_pages({}));
+
+  const HugePageStats stats = market.get_huge_page_stats();
+  CHECK(stats.huge_pages + stats.transparent_pages + stats.normal_pages != 0);
+  CHECK(market.get_order_book(0)->get_best_bid_order() ==
+        market.query_order(0));
+}
+
+/***/
+TEST_CASE("market_traded_volume_keeps_memory_bounded") {
+  // The same flow with and without volume queries maps about as many pages,
+  // give or take the scratch buffer growing geometrically.
+  std::size_t pages[2];
+  for (const bool query : {false, true}) {
+    Market market{"nyse", "NYSE"};
+    CHECK(market.set_huge_pages(
+        {HugePageMode::Off, std::size_t{2} << 20, std::size_t{2} << 20}));
+    market.add_stock("stock1", "AAPL");
+    for (std::size_t i = 0; i < 64 * OrderStore::chunk_size; ++i) {
+      market.add_order<LimitOrder::OrderType::Bid>(0, 100, 10);
+      if (query && i % OrderStore::chunk_size == 0) {
+        CHECK(market.get_traded_volume(0) == 0);
+      }
+    }
+    const HugePageStats stats = market.get_huge_page_stats();
+    pages[query] = stats.normal_pages;
+  }
+  CHECK(pages[1] <= pages[0] + 4 * (std::size_t{2} << 20) / 4096);
+}
+
+/***/
+TEST_CASE("market_load_universe") {
+  const std::string csv_path =
+      (std::filesystem::temp_directory_path() / "clob_universe.csv").string();
+  std::ofstream{csv_path} << "name,ticker,tick_size,lot_size\n"
+                             "Apple,AAPL,1,100\n"
+                             "Apple again,AAPL,1,100\n"
+                             "Alphabet,GOOGL,5,10\n"
+                             "Broken,BRK\n"
+                             "Microsoft,MSFT,1,1\n";
+  Market market{"nyse", "NYSE"};
+  CHECK(market.load_universe(csv_path + ".missing") == 0);
+  market.add_stock("Tesla", "TSLA");
+  CHECK(market.load_universe(csv_path) == 2);
+  CHECK(market.get_num_stocks() == 3);
+  const Stock *alphabet = market.find_stock("GOOGL");
+  REQUIRE(alphabet != nullptr);
+  CHECK(alphabet->id == 2);
+  CHECK(alphabet->name == "Alphabet");
+  CHECK(alphabet->tick_size == 5);
+  CHECK(alphabet->lot_size == 10);
+  CHECK(market.find_stock("MSFT") == nullptr);
+  REQUIRE(market.get_order_book(2) != nullptr);
+
+  const std::string bin_path =
+      (std::filesystem::temp_directory_path() / "clob_universe.bin").string();
+  std::vector<ReferenceRecord> records;
+  std::vector<std::string> tickers;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    tickers.push_back("T" + std::to_string(i));
+  }
+  for (const std::string &ticker : tickers) {
+    records.push_back({"instrument", ticker, 1, 1});
+  }
+  REQUIRE(ReferenceFile::write(bin_path, records));
+  Market loaded{"nyse", "NYSE"};
+  CHECK(loaded.load_universe(bin_path) == 1000);
+  CHECK(loaded.freeze_stocks());
+  REQUIRE(loaded.find_stock("T999") != nullptr);
+  CHECK(loaded.find_stock("T999")->id == 999);
+  CHECK(loaded.add_order<LimitOrder::OrderType::Bid>(999, 100, 10) == 0);
+  CHECK(loaded.get_order_book(999)->bids_size() == 1);
+  std::filesystem::remove(csv_path);
+  std::filesystem::remove(bin_path);
+}
+
+/***/
+TEST_CASE("market_memory_resource") {
+  // Everything the market allocates must fit the buffer: the upstream
+  // resource throws on any request.
+  std::vector<std::byte> buffer(std::size_t{8} << 20);
+  std::pmr::monotonic_buffer_resource resource{
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+  for (int round = 0; round < 2; ++round) {
+    {
+      Market market{"nyse", "NYSE", &resource};
+      CHECK(market.get_allocator().resource() == &resource);
+      CHECK_FALSE(market.set_huge_pages({HugePageMode::Transparent}));
+      market.reserve(16, OrderStore::chunk_size);
+      market.add_stock("stock1", "AAPL");
+      market.add_stock("stock2", "MSFT");
+      for (std::size_t i = 0; i < 2 * OrderStore::chunk_size; ++i) {
+        market.add_order<LimitOrder::OrderType::Ask>(i % 2, 100 + i % 7, 10);
+      }
+      CHECK(market.add_order<LimitOrder::OrderType::Bid>(0, 110, 30) ==
+            2 * OrderStore::chunk_size);
+      CHECK(market.get_traded_volume(0) == 30);
+      CHECK(market.cancel_all_orders(1) == OrderStore::chunk_size);
+      CHECK(market.get_order_book(1)->asks_size() == 0);
+      CHECK(market.get_exchange_name() == "nyse");
+      CHECK(market.get_huge_page_stats().normal_pages == 0);
+    }
+    resource.release();
+  }
+}
+
+/***/
+TEST_CASE("market_steady_state_allocates_nothing") {
+  CountingResource resource;
+  Market market{"nyse", "NYSE", &resource};
+  market.add_stock("stock1", "AAPL");
+  REQUIRE(market.set_order_capacity(OrderStore::chunk_size));
+  // Every level keeps a resting order throughout, so only order storage is
+  // exercised: each round rests a bid, cancels it and trades the front ask
+  // at the touch before replacing it at the back of the level.
+  const auto round = [&market] {
+    const LimitOrder::id_t bid =
+        market.add_order<LimitOrder::OrderType::Bid>(0, 90, 10);
+    CHECK(market.cancel_order(bid));
+    market.add_order<LimitOrder::OrderType::Bid>(0, 100, 10);
+    market.add_order<LimitOrder::OrderType::Ask>(0, 100, 10);
+  };
+  market.add_order<LimitOrder::OrderType::Bid>(0, 90, 10);
+  for (price_t price = 100; price < 116; ++price) {
+    market.add_order<LimitOrder::OrderType::Ask>(0, price, 10);
+    market.add_order<LimitOrder::OrderType::Ask>(0, price, 10);
+  }
+  // Warm up past the table size so that every slot has been reused.
+  for (std::size_t i = 0; i < OrderStore::chunk_size; ++i) {
+    round();
+  }
+  const std::size_t allocations = resource.allocations;
+  for (std::size_t i = 0; i < 4 * OrderStore::chunk_size; ++i) {
+    round();
+  }
+  CHECK(resource.allocations == allocations);
+  CHECK(market.get_order_book(0)->asks_size() == 32);
+  CHECK(market.get_order_book(0)->bids_size() == 1);
+  CHECK(market.get_num_order_chunks() == 1);
+}
+
 TEST_SUITE_END();
\ No newline at end of file
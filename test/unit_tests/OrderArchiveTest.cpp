@@ -0,0 +1,74 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/LimitOrder.h"
+#include "clob/OrderArchive.h"
+
+TEST_SUITE_BEGIN("OrderArchive");
+
+using namespace clob;
+
+namespace {
+
+std::string archive_path(const char *name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<ArchivedOrder> make_block(const std::uint64_t first,
+                                      const std::size_t size) {
+  std::vector<ArchivedOrder> block;
+  for (std::uint64_t id = first; id < first + size; ++id) {
+    block.push_back({id, 1000 + id, id, -static_cast<std::int64_t>(id),
+                     15000, 100, 100, 7, LimitOrder::OrderType::Ask, false});
+  }
+  return block;
+}
+
+} // namespace
+
+/***/
+TEST_CASE("order_archive_closed") {
+  OrderArchive archive{4};
+  ArchivedOrder order;
+  CHECK_FALSE(archive.is_open());
+  CHECK_FALSE(archive.append(0, make_block(0, 4)));
+  CHECK_FALSE(archive.read(0, order));
+}
+
+/***/
+TEST_CASE("order_archive_read_back") {
+  const std::string path = archive_path("clob_order_archive_test.bin");
+  {
+    OrderArchive archive{4};
+    REQUIRE(archive.open(path));
+    CHECK(archive.append(2, make_block(8, 4)));
+    CHECK(archive.append(0, make_block(0, 4)));
+    CHECK_FALSE(archive.append(0, make_block(0, 4)));
+    CHECK_FALSE(archive.append(1, make_block(4, 5)));
+    CHECK(archive.size() == 8);
+
+    ArchivedOrder order;
+    REQUIRE(archive.read(9, order));
+    CHECK(order.id == 9);
+    CHECK(order.timestamp == 1009);
+    CHECK(order.sequence == 9);
+    CHECK(order.balance == -9);
+    CHECK(order.stock_id == 7);
+    CHECK(order.order_type == LimitOrder::OrderType::Ask);
+    CHECK(order.reserved[0] == 0);
+    CHECK(order.reserved[2] == 0);
+    REQUIRE(archive.read(3, order));
+    CHECK(order.id == 3);
+    CHECK_FALSE(archive.read(4, order));
+    CHECK_FALSE(archive.read(12, order));
+  }
+  std::filesystem::remove(path);
+}
+
+TEST_SUITE_END();
\ No newline at end of file
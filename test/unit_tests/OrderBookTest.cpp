@@ -1,13 +1,19 @@
 #include "doctest/doctest.h"
 
 #include <cstdint>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <random>
+#include <span>
 #include <type_traits>
+#include <vector>
 #include <utility>
 
 #include "misc/TestUtilities.h"
 
 #include "clob/OrderBook.h"
+#include "clob/OrderBookImpl.h"
 
 TEST_SUITE_BEGIN("OrderBook");
 
@@ -33,7 +39,7 @@ TEST_CASE("add_bid_order_single") {
 
   const LimitOrder *top_bid = order_book.get_best_bid_order();
   CHECK(top_bid->id == 1);
-  CHECK(top_bid->timestamp == 1000);
+  CHECK(top_bid->sequence == 1000);
   CHECK(top_bid->price == 15000);
   CHECK(top_bid->quantity == 100);
   CHECK(top_bid->filled_quantity == 0);
@@ -50,7 +56,7 @@ TEST_CASE("add_ask_order_single") {
 
   const LimitOrder *top_ask = order_book.get_best_ask_order();
   CHECK(top_ask->id == 2);
-  CHECK(top_ask->timestamp == 2000);
+  CHECK(top_ask->sequence == 2000);
   CHECK(top_ask->price == 16000);
   CHECK(top_ask->quantity == 200);
   CHECK(top_ask->filled_quantity == 0);
@@ -119,7 +125,7 @@ TEST_CASE("bid_order_priority_time") {
 
   const LimitOrder *best_bid = order_book.get_best_bid_order();
   CHECK(best_bid->id == 1);
-  CHECK(best_bid->timestamp == 1000);
+  CHECK(best_bid->sequence == 1000);
 }
 
 TEST_CASE("ask_order_priority_price") {
@@ -149,7 +155,7 @@ TEST_CASE("ask_order_priority_time") {
 
   const LimitOrder *best_ask = order_book.get_best_ask_order();
   CHECK(best_ask->id == 1);
-  CHECK(best_ask->timestamp == 1000);
+  CHECK(best_ask->sequence == 1000);
 }
 
 TEST_CASE("order_matching_exact_price") {
@@ -293,7 +299,7 @@ TEST_CASE("cancel_later_ask_order") {
 
   auto ask_order = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
   order_book.add_ask_order(ask_order.get());
-  ask_order->is_cancelled = true;
+  CHECK(order_book.cancel_ask_order(ask_order.get()));
 
   auto bid_order = std::make_unique<LimitOrder>(2, 1100, 15000, 100);
   order_book.add_bid_order(bid_order.get());
@@ -310,7 +316,7 @@ TEST_CASE("cancel_later_bid_order") {
 
   auto bid_order = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
   order_book.add_bid_order(bid_order.get());
-  bid_order->is_cancelled = true;
+  CHECK(order_book.cancel_bid_order(bid_order.get()));
 
   auto ask_order = std::make_unique<LimitOrder>(2, 1100, 15000, 100);
   order_book.add_ask_order(ask_order.get());
@@ -541,7 +547,7 @@ TEST_CASE("aggressive_cross_price_matching") {
   CHECK(ask1->balance == 400 * 50000 + 600 * 49800 + 300 * 50200);
 }
 
-TEST_CASE("complex_interlaced_timestamps") {
+TEST_CASE("complex_interlaced_sequences") {
   OrderBook order_book;
 
   auto bid1 = std::make_unique<LimitOrder>(101, 15000, 50000, 500);
@@ -552,7 +558,8 @@ TEST_CASE("complex_interlaced_timestamps") {
   order_book.add_bid_order(bid2.get());
   order_book.add_bid_order(bid3.get());
   order_book.add_bid_order(bid4.get());
-  CHECK(order_book.get_best_bid_order()->id == 102);
+  // A level keeps arrival order, its sequence numbers are never compared.
+  CHECK(order_book.get_best_bid_order()->id == 101);
 
   auto ask1 = std::make_unique<LimitOrder>(201, 12000, 50000, 1000);
   order_book.add_ask_order(ask1.get());
@@ -769,4 +776,787 @@ TEST_CASE("ultimate_comprehensive_order_book_test") {
         35000LL * 1030000 + 27000LL * 1025000 + 25000LL * 1018000);
 }
 
+TEST_CASE("orders_share_price_levels") {
+  OrderBook order_book;
+
+  auto bid1 = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  auto bid2 = std::make_unique<LimitOrder>(2, 1100, 15000, 100);
+  auto bid3 = std::make_unique<LimitOrder>(3, 1200, 14900, 100);
+  auto ask1 = std::make_unique<LimitOrder>(4, 1300, 15100, 100);
+  auto ask2 = std::make_unique<LimitOrder>(5, 1400, 15100, 100);
+
+  order_book.add_bid_order(bid1.get());
+  order_book.add_bid_order(bid2.get());
+  order_book.add_bid_order(bid3.get());
+  order_book.add_ask_order(ask1.get());
+  order_book.add_ask_order(ask2.get());
+  CHECK(order_book.bids_size() == 3);
+  CHECK(order_book.bid_levels_size() == 2);
+  CHECK(order_book.asks_size() == 2);
+  CHECK(order_book.ask_levels_size() == 1);
+
+  auto bid4 = std::make_unique<LimitOrder>(6, 1500, 15100, 200);
+  order_book.add_bid_order(bid4.get());
+  CHECK(order_book.asks_size() == 0);
+  CHECK(order_book.ask_levels_size() == 0);
+  CHECK(order_book.get_best_ask_order() == nullptr);
+  CHECK(bid4->filled_quantity == 200);
+}
+
+TEST_CASE("cancel_resting_orders") {
+  OrderBook order_book;
+
+  auto bid1 = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  auto bid2 = std::make_unique<LimitOrder>(2, 1100, 15000, 100);
+  auto bid3 = std::make_unique<LimitOrder>(3, 1200, 15000, 100);
+  auto bid4 = std::make_unique<LimitOrder>(4, 1300, 15100, 100);
+  order_book.add_bid_order(bid1.get());
+  order_book.add_bid_order(bid2.get());
+  order_book.add_bid_order(bid3.get());
+  order_book.add_bid_order(bid4.get());
+  REQUIRE(order_book.bids_size() == 4);
+  REQUIRE(order_book.bid_levels_size() == 2);
+
+  CHECK(order_book.cancel_bid_order(bid4.get()));
+  CHECK(bid4->is_cancelled);
+  CHECK(bid4->level == nullptr);
+  CHECK(order_book.bids_size() == 3);
+  CHECK(order_book.bid_levels_size() == 1);
+  REQUIRE(order_book.get_best_bid_order() != nullptr);
+  CHECK(order_book.get_best_bid_order()->id == 1);
+
+  CHECK(order_book.cancel_bid_order(bid2.get()));
+  CHECK(order_book.bids_size() == 2);
+  CHECK(bid1->next == bid3.get());
+  CHECK(bid3->prev == bid1.get());
+
+  CHECK(order_book.cancel_bid_order(bid1.get()));
+  REQUIRE(order_book.get_best_bid_order() != nullptr);
+  CHECK(order_book.get_best_bid_order()->id == 3);
+
+  CHECK_FALSE(order_book.cancel_bid_order(bid1.get()));
+  CHECK(order_book.cancel_bid_order(bid3.get()));
+  CHECK(order_book.bids_size() == 0);
+  CHECK(order_book.bid_levels_size() == 0);
+  CHECK(order_book.get_best_bid_order() == nullptr);
+}
+
+TEST_CASE("cancelled_orders_do_not_match") {
+  OrderBook order_book;
+
+  auto ask1 = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  auto ask2 = std::make_unique<LimitOrder>(2, 1100, 15000, 100);
+  order_book.add_ask_order(ask1.get());
+  order_book.add_ask_order(ask2.get());
+  CHECK(order_book.cancel_ask_order(ask1.get()));
+  CHECK(order_book.asks_size() == 1);
+
+  auto bid = std::make_unique<LimitOrder>(3, 1200, 15000, 150);
+  order_book.add_bid_order(bid.get());
+  CHECK(ask1->filled_quantity == 0);
+  CHECK(ask2->filled_quantity == 100);
+  CHECK(bid->filled_quantity == 100);
+  CHECK(order_book.asks_size() == 0);
+  CHECK(order_book.bids_size() == 1);
+
+  CHECK_FALSE(order_book.cancel_ask_order(ask2.get()));
+  CHECK(order_book.cancel_bid_order(bid.get()));
+  CHECK(order_book.bids_size() == 0);
+}
+
+TEST_CASE("dense_order_book_matching") {
+  DenseOrderBook order_book{{14000, 10, 200}};
+
+  auto bid1 = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  auto bid2 = std::make_unique<LimitOrder>(2, 1100, 15010, 100);
+  auto bid3 = std::make_unique<LimitOrder>(3, 1200, 15000, 100);
+  order_book.add_bid_order(bid1.get());
+  order_book.add_bid_order(bid2.get());
+  order_book.add_bid_order(bid3.get());
+  CHECK(order_book.bids_size() == 3);
+  CHECK(order_book.bid_levels_size() == 2);
+  REQUIRE(order_book.get_best_bid_order() != nullptr);
+  CHECK(order_book.get_best_bid_order()->id == 2);
+
+  auto ask1 = std::make_unique<LimitOrder>(4, 1300, 14990, 250);
+  order_book.add_ask_order(ask1.get());
+  CHECK(ask1->filled_quantity == 250);
+  CHECK(bid2->filled_quantity == 100);
+  CHECK(bid1->filled_quantity == 100);
+  CHECK(bid3->filled_quantity == 50);
+  CHECK(ask1->balance == 100 * 15010 + 150 * 15000);
+  CHECK(order_book.bids_size() == 1);
+  CHECK(order_book.asks_size() == 0);
+  REQUIRE(order_book.get_best_bid_order() != nullptr);
+  CHECK(order_book.get_best_bid_order()->id == 3);
+
+  CHECK(order_book.cancel_bid_order(bid3.get()));
+  CHECK(order_book.get_best_bid_order() == nullptr);
+  CHECK(order_book.bid_levels_size() == 0);
+}
+
+TEST_CASE("dense_order_book_rejects_prices_outside_band") {
+  DenseOrderBook order_book{{14000, 10, 200}};
+
+  auto bid1 = std::make_unique<LimitOrder>(1, 1000, 13990, 100);
+  auto bid2 = std::make_unique<LimitOrder>(2, 1100, 15005, 100);
+  auto ask1 = std::make_unique<LimitOrder>(3, 1200, 16000, 100);
+  order_book.add_bid_order(bid1.get());
+  order_book.add_bid_order(bid2.get());
+  order_book.add_ask_order(ask1.get());
+  CHECK(bid1->is_cancelled);
+  CHECK(bid2->is_cancelled);
+  CHECK(ask1->is_cancelled);
+  CHECK(order_book.bids_size() == 0);
+  CHECK(order_book.asks_size() == 0);
+}
+
+TEST_CASE("level_aggregates") {
+  OrderBook order_book;
+
+  auto bid1 = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  auto bid2 = std::make_unique<LimitOrder>(2, 1100, 15000, 200);
+  auto bid3 = std::make_unique<LimitOrder>(3, 1200, 14900, 300);
+  order_book.add_bid_order(bid1.get());
+  order_book.add_bid_order(bid2.get());
+  order_book.add_bid_order(bid3.get());
+
+  const PriceLevel *best_bid = order_book.get_best_bid_level();
+  REQUIRE(best_bid != nullptr);
+  CHECK(best_bid->price == 15000);
+  CHECK(best_bid->total_quantity == 300);
+  CHECK(best_bid->order_count == 2);
+  CHECK(order_book.get_best_ask_level() == nullptr);
+
+  auto ask1 = std::make_unique<LimitOrder>(4, 1300, 15000, 150);
+  order_book.add_ask_order(ask1.get());
+  best_bid = order_book.get_best_bid_level();
+  REQUIRE(best_bid != nullptr);
+  CHECK(best_bid->total_quantity == 150);
+  CHECK(best_bid->order_count == 1);
+
+  CHECK(order_book.modify_bid_order(bid2.get(), 15000, 100, 1400));
+  CHECK(order_book.get_best_bid_level()->total_quantity == 50);
+
+  DepthLevel depth[4];
+  CHECK(order_book.get_bid_depth(depth) == 2);
+  CHECK(depth[0].price == 15000);
+  CHECK(depth[0].quantity == 50);
+  CHECK(depth[0].num_orders == 1);
+  CHECK(depth[1].price == 14900);
+  CHECK(depth[1].quantity == 300);
+  CHECK(depth[1].num_orders == 1);
+  CHECK(order_book.get_bid_depth(std::span<DepthLevel>{depth, 1}) == 1);
+  CHECK(order_book.get_ask_depth(depth) == 0);
+
+  CHECK(order_book.cancel_bid_order(bid3.get()));
+  CHECK(order_book.get_bid_depth(depth) == 1);
+}
+
+TEST_CASE("sweep_consumes_whole_levels") {
+  OrderBook order_book;
+
+  auto ask1 = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  auto ask2 = std::make_unique<LimitOrder>(2, 1100, 15000, 50);
+  auto ask3 = std::make_unique<LimitOrder>(3, 1200, 15000, 70);
+  auto ask4 = std::make_unique<LimitOrder>(4, 1300, 15100, 200);
+  auto ask5 = std::make_unique<LimitOrder>(5, 1400, 15200, 100);
+  order_book.add_ask_order(ask1.get());
+  order_book.add_ask_order(ask2.get());
+  order_book.add_ask_order(ask3.get());
+  order_book.add_ask_order(ask4.get());
+  order_book.add_ask_order(ask5.get());
+  CHECK(order_book.cancel_ask_order(ask2.get()));
+
+  auto bid = std::make_unique<LimitOrder>(6, 1500, 15200, 400);
+  order_book.add_bid_order(bid.get());
+
+  CHECK(bid->filled_quantity == 400);
+  CHECK(bid->balance == -(170 * 15000 + 200 * 15100 + 30 * 15200));
+  CHECK(ask1->filled_quantity == 100);
+  CHECK(ask1->balance == 100 * 15000);
+  CHECK(ask2->filled_quantity == 0);
+  CHECK(ask2->balance == 0);
+  CHECK(ask3->filled_quantity == 70);
+  CHECK(ask4->filled_quantity == 200);
+  CHECK(ask4->balance == 200 * 15100);
+  CHECK(ask5->filled_quantity == 30);
+  CHECK(ask1->level == nullptr);
+  CHECK(ask2->level == nullptr);
+  CHECK(ask4->level == nullptr);
+
+  CHECK(order_book.asks_size() == 1);
+  CHECK(order_book.ask_levels_size() == 1);
+  CHECK(order_book.bids_size() == 0);
+  CHECK_FALSE(order_book.cancel_ask_order(ask1.get()));
+  const PriceLevel *best_ask = order_book.get_best_ask_level();
+  REQUIRE(best_ask != nullptr);
+  CHECK(best_ask->price == 15200);
+  CHECK(best_ask->total_quantity == 70);
+}
+
+TEST_CASE("filled_handler_reports_filled_resting_orders") {
+  OrderBook order_book;
+  std::vector<LimitOrder *> filled;
+  order_book.set_filled_handler(
+      [](void *context, LimitOrder *order) {
+        static_cast<std::vector<LimitOrder *> *>(context)->push_back(order);
+      },
+      &filled);
+
+  auto ask1 = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  auto ask2 = std::make_unique<LimitOrder>(2, 1100, 15000, 50);
+  auto ask3 = std::make_unique<LimitOrder>(3, 1200, 15100, 60);
+  order_book.add_ask_order(ask1.get());
+  order_book.add_ask_order(ask2.get());
+  order_book.add_ask_order(ask3.get());
+
+  // A whole level swept at once.
+  auto bid1 = std::make_unique<LimitOrder>(4, 1300, 15000, 150);
+  order_book.add_bid_order(bid1.get());
+  CHECK(filled == std::vector<LimitOrder *>{ask1.get(), ask2.get()});
+
+  // A partial fill leaves the order resting, the next fill completes it.
+  auto bid2 = std::make_unique<LimitOrder>(5, 1400, 15100, 30);
+  order_book.add_bid_order(bid2.get());
+  CHECK(filled.size() == 2);
+  auto bid3 = std::make_unique<LimitOrder>(6, 1500, 15100, 40);
+  order_book.add_bid_order(bid3.get());
+  CHECK(filled.size() == 3);
+  CHECK(filled.back() == ask3.get());
+  CHECK(ask3->level == nullptr);
+  CHECK(order_book.bids_size() == 1);
+}
+
+TEST_CASE("order_book_ladders_agree") {
+  OrderBook order_book;
+  DenseOrderBook dense_order_book{{9000, 1, 2001}};
+  HybridOrderBook hybrid_order_book{{1, 64}};
+  std::vector<std::unique_ptr<LimitOrder>> orders[3];
+
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<int> action_dist{0, 9};
+  std::uniform_int_distribution<price_t> price_dist{9800, 10200};
+  std::uniform_int_distribution<quantity_t> quantity_dist{1, 100};
+
+  for (LimitOrder::id_t id = 0; id < 5000; ++id) {
+    const int action = action_dist(rng);
+    const price_t price = price_dist(rng);
+    const quantity_t quantity = quantity_dist(rng);
+    if (action < 2 && id > 0) {
+      const auto target = std::uniform_int_distribution<LimitOrder::id_t>{
+          0, id - 1}(rng);
+      const bool is_bid = target % 2 == 0;
+      const bool cancelled =
+          is_bid ? order_book.cancel_bid_order(orders[0][target].get())
+                 : order_book.cancel_ask_order(orders[0][target].get());
+      CHECK(cancelled == (is_bid ? dense_order_book.cancel_bid_order(
+                                       orders[1][target].get())
+                                 : dense_order_book.cancel_ask_order(
+                                       orders[1][target].get())));
+      CHECK(cancelled == (is_bid ? hybrid_order_book.cancel_bid_order(
+                                       orders[2][target].get())
+                                 : hybrid_order_book.cancel_ask_order(
+                                       orders[2][target].get())));
+    }
+    for (auto &book_orders : orders) {
+      book_orders.push_back(
+          std::make_unique<LimitOrder>(id, id, price, quantity));
+    }
+    if (id % 2 == 0) {
+      order_book.add_bid_order(orders[0].back().get());
+      dense_order_book.add_bid_order(orders[1].back().get());
+      hybrid_order_book.add_bid_order(orders[2].back().get());
+    } else {
+      order_book.add_ask_order(orders[0].back().get());
+      dense_order_book.add_ask_order(orders[1].back().get());
+      hybrid_order_book.add_ask_order(orders[2].back().get());
+    }
+
+    REQUIRE(dense_order_book.bids_size() == order_book.bids_size());
+    REQUIRE(dense_order_book.asks_size() == order_book.asks_size());
+    REQUIRE(hybrid_order_book.bids_size() == order_book.bids_size());
+    REQUIRE(hybrid_order_book.asks_size() == order_book.asks_size());
+    REQUIRE(hybrid_order_book.bid_levels_size() ==
+            order_book.bid_levels_size());
+    REQUIRE(hybrid_order_book.ask_levels_size() ==
+            order_book.ask_levels_size());
+    const LimitOrder *best_bid = order_book.get_best_bid_order();
+    const LimitOrder *best_ask = order_book.get_best_ask_order();
+    REQUIRE((best_bid == nullptr) ==
+            (hybrid_order_book.get_best_bid_order() == nullptr));
+    REQUIRE((best_ask == nullptr) ==
+            (hybrid_order_book.get_best_ask_order() == nullptr));
+    if (best_bid != nullptr) {
+      REQUIRE(hybrid_order_book.get_best_bid_order()->id == best_bid->id);
+      REQUIRE(dense_order_book.get_best_bid_order()->id == best_bid->id);
+    }
+    if (best_ask != nullptr) {
+      REQUIRE(hybrid_order_book.get_best_ask_order()->id == best_ask->id);
+      REQUIRE(dense_order_book.get_best_ask_order()->id == best_ask->id);
+    }
+
+    if (id % 250 == 0) {
+      DepthLevel depth[3][512];
+      const std::size_t bid_levels = order_book.get_bid_depth(depth[0]);
+      REQUIRE(dense_order_book.get_bid_depth(depth[1]) == bid_levels);
+      REQUIRE(hybrid_order_book.get_bid_depth(depth[2]) == bid_levels);
+      for (std::size_t i = 0; i < bid_levels; ++i) {
+        REQUIRE(depth[1][i].price == depth[0][i].price);
+        REQUIRE(depth[2][i].price == depth[0][i].price);
+        REQUIRE(depth[1][i].quantity == depth[0][i].quantity);
+        REQUIRE(depth[2][i].quantity == depth[0][i].quantity);
+        REQUIRE(depth[2][i].num_orders == depth[0][i].num_orders);
+      }
+      const std::size_t ask_levels = order_book.get_ask_depth(depth[0]);
+      REQUIRE(dense_order_book.get_ask_depth(depth[1]) == ask_levels);
+      REQUIRE(hybrid_order_book.get_ask_depth(depth[2]) == ask_levels);
+      for (std::size_t i = 0; i < ask_levels; ++i) {
+        REQUIRE(depth[1][i].price == depth[0][i].price);
+        REQUIRE(depth[2][i].price == depth[0][i].price);
+        REQUIRE(depth[2][i].quantity == depth[0][i].quantity);
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < orders[0].size(); ++i) {
+    REQUIRE(orders[1][i]->filled_quantity == orders[0][i]->filled_quantity);
+    REQUIRE(orders[2][i]->filled_quantity == orders[0][i]->filled_quantity);
+    REQUIRE(orders[1][i]->balance == orders[0][i]->balance);
+    REQUIRE(orders[2][i]->balance == orders[0][i]->balance);
+  }
+}
+
+TEST_CASE_TEMPLATE("order_book_level_stores_agree", Book, HeapOrderBook,
+                   FlatOrderBook) {
+  MapOrderBook reference;
+  Book order_book;
+  std::vector<std::unique_ptr<LimitOrder>> orders[2];
+
+  std::mt19937 rng{7};
+  std::uniform_int_distribution<int> action_dist{0, 9};
+  std::uniform_int_distribution<price_t> price_dist{9900, 10100};
+  std::uniform_int_distribution<quantity_t> quantity_dist{1, 100};
+
+  for (LimitOrder::id_t id = 0; id < 5000; ++id) {
+    const int action = action_dist(rng);
+    const price_t price = price_dist(rng);
+    const quantity_t quantity = quantity_dist(rng);
+    if (action < 3 && id > 0) {
+      const auto target = std::uniform_int_distribution<LimitOrder::id_t>{
+          0, id - 1}(rng);
+      LimitOrder *lhs = orders[0][target].get();
+      LimitOrder *rhs = orders[1][target].get();
+      if (target % 2 == 0) {
+        REQUIRE(reference.modify_bid_order(lhs, price, quantity, id) ==
+                order_book.modify_bid_order(rhs, price, quantity, id));
+      } else {
+        REQUIRE(reference.cancel_ask_order(lhs) ==
+                order_book.cancel_ask_order(rhs));
+      }
+    }
+    for (auto &book_orders : orders) {
+      book_orders.push_back(
+          std::make_unique<LimitOrder>(id, id, price, quantity));
+    }
+    if (id % 2 == 0) {
+      reference.add_bid_order(orders[0].back().get());
+      order_book.add_bid_order(orders[1].back().get());
+    } else {
+      reference.add_ask_order(orders[0].back().get());
+      order_book.add_ask_order(orders[1].back().get());
+    }
+
+    REQUIRE(order_book.bids_size() == reference.bids_size());
+    REQUIRE(order_book.asks_size() == reference.asks_size());
+    REQUIRE(order_book.bid_levels_size() == reference.bid_levels_size());
+    REQUIRE(order_book.ask_levels_size() == reference.ask_levels_size());
+    const LimitOrder *best_bid = reference.get_best_bid_order();
+    const LimitOrder *best_ask = reference.get_best_ask_order();
+    REQUIRE((best_bid == nullptr) ==
+            (order_book.get_best_bid_order() == nullptr));
+    REQUIRE((best_ask == nullptr) ==
+            (order_book.get_best_ask_order() == nullptr));
+    if (best_bid != nullptr) {
+      REQUIRE(order_book.get_best_bid_order()->id == best_bid->id);
+    }
+    if (best_ask != nullptr) {
+      REQUIRE(order_book.get_best_ask_order()->id == best_ask->id);
+    }
+
+    if (id % 250 == 0) {
+      DepthLevel depth[2][256];
+      const std::size_t bid_levels = reference.get_bid_depth(depth[0]);
+      REQUIRE(order_book.get_bid_depth(depth[1]) == bid_levels);
+      for (std::size_t i = 0; i < bid_levels; ++i) {
+        REQUIRE(depth[1][i].price == depth[0][i].price);
+        REQUIRE(depth[1][i].quantity == depth[0][i].quantity);
+      }
+      const std::size_t ask_levels = reference.get_ask_depth(depth[0]);
+      REQUIRE(order_book.get_ask_depth(depth[1]) == ask_levels);
+      for (std::size_t i = 0; i < ask_levels; ++i) {
+        REQUIRE(depth[1][i].price == depth[0][i].price);
+        REQUIRE(depth[1][i].num_orders == depth[0][i].num_orders);
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < orders[0].size(); ++i) {
+    REQUIRE(orders[1][i]->filled_quantity == orders[0][i]->filled_quantity);
+    REQUIRE(orders[1][i]->balance == orders[0][i]->balance);
+  }
+}
+
+namespace {
+
+std::size_t allocations{0};
+
+template <typename T> struct CountingAllocator {
+  using value_type = T;
+
+  CountingAllocator() = default;
+  template <typename U> CountingAllocator(const CountingAllocator<U> &) {}
+
+  T *allocate(const std::size_t n) {
+    ++allocations;
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T *p, const std::size_t n) {
+    std::allocator<T>{}.deallocate(p, n);
+  }
+  template <typename U> bool operator==(const CountingAllocator<U> &) const {
+    return true;
+  }
+};
+
+} // namespace
+
+TEST_CASE("order_book_custom_allocator") {
+  BasicOrderBook<PriceLadder, LimitOrder::PriceTimeQueuePriority,
+                 CountingAllocator<PriceLevel>>
+      order_book;
+  allocations = 0;
+
+  auto bid = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  auto ask = std::make_unique<LimitOrder>(2, 1100, 15100, 100);
+  order_book.add_bid_order(bid.get());
+  order_book.add_ask_order(ask.get());
+  CHECK(allocations == 2);
+  CHECK(order_book.bid_levels_size() == 1);
+  CHECK(order_book.ask_levels_size() == 1);
+}
+
+TEST_CASE("order_book_memory_resource") {
+  // The levels must fit the buffer: the upstream resource throws on any
+  // request.
+  std::byte buffer[16384];
+  std::pmr::monotonic_buffer_resource resource{
+      buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+  std::vector<LimitOrder> asks;
+  for (std::size_t i = 0; i < 64; ++i) {
+    asks.emplace_back(i, i, 15000 + i % 8, 10);
+  }
+  LimitOrder bid{64, 64, 15007, 640};
+
+  PmrOrderBook::config_t config{};
+  [](auto &store_config) {
+    // Keep a dense window within the buffer, whatever the level store.
+    if constexpr (requires { store_config.window_ticks; }) {
+      store_config.window_ticks = 16;
+    }
+  }(config);
+  PmrOrderBook order_book{config, &resource};
+  for (auto &ask : asks) {
+    order_book.add_ask_order(&ask);
+  }
+  CHECK(order_book.ask_levels_size() == 8);
+  order_book.add_bid_order(&bid);
+  CHECK(bid.filled_quantity == 640);
+  CHECK(order_book.asks_size() == 0);
+  CHECK(order_book.ask_levels_size() == 0);
+}
+
+TEST_CASE("modify_order_in_place_keeps_priority") {
+  OrderBook order_book;
+
+  auto bid1 = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  auto bid2 = std::make_unique<LimitOrder>(2, 1100, 15000, 100);
+  order_book.add_bid_order(bid1.get());
+  order_book.add_bid_order(bid2.get());
+
+  CHECK(order_book.modify_bid_order(bid1.get(), 15000, 60, 2000));
+  CHECK(bid1->quantity == 60);
+  CHECK(bid1->sequence == 1000);
+  REQUIRE(order_book.get_best_bid_order() != nullptr);
+  CHECK(order_book.get_best_bid_order()->id == 1);
+
+  CHECK(order_book.modify_bid_order(bid1.get(), 15000, 80, 2100));
+  CHECK(bid1->quantity == 80);
+  CHECK(bid1->sequence == 2100);
+  REQUIRE(order_book.get_best_bid_order() != nullptr);
+  CHECK(order_book.get_best_bid_order()->id == 2);
+  CHECK(order_book.bids_size() == 2);
+  CHECK(order_book.bid_levels_size() == 1);
+}
+
+TEST_CASE("modify_order_price_requeues_and_matches") {
+  OrderBook order_book;
+
+  auto ask1 = std::make_unique<LimitOrder>(1, 1000, 15100, 100);
+  auto bid1 = std::make_unique<LimitOrder>(2, 1100, 15000, 100);
+  auto bid2 = std::make_unique<LimitOrder>(3, 1200, 14900, 100);
+  order_book.add_ask_order(ask1.get());
+  order_book.add_bid_order(bid1.get());
+  order_book.add_bid_order(bid2.get());
+
+  CHECK(order_book.modify_bid_order(bid2.get(), 15000, 100, 1300));
+  CHECK(order_book.bid_levels_size() == 1);
+  REQUIRE(order_book.get_best_bid_order() != nullptr);
+  CHECK(order_book.get_best_bid_order()->id == 2);
+
+  CHECK(order_book.modify_bid_order(bid2.get(), 15100, 150, 1400));
+  CHECK(bid2->filled_quantity == 100);
+  CHECK(ask1->filled_quantity == 100);
+  CHECK(bid2->balance == -100 * 15100);
+  CHECK(order_book.asks_size() == 0);
+  CHECK(order_book.bids_size() == 2);
+  REQUIRE(order_book.get_best_bid_order() != nullptr);
+  CHECK(order_book.get_best_bid_order()->id == 3);
+
+  CHECK(order_book.modify_bid_order(bid2.get(), 15100, 100, 1500));
+  CHECK(bid2->is_cancelled);
+  CHECK(bid2->level == nullptr);
+  CHECK(order_book.bids_size() == 1);
+  CHECK_FALSE(order_book.modify_bid_order(bid2.get(), 15100, 200, 1600));
+}
+
+TEST_CASE("dense_order_book_modify_outside_band") {
+  DenseOrderBook order_book{{14000, 10, 200}};
+
+  auto ask1 = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  order_book.add_ask_order(ask1.get());
+  CHECK_FALSE(order_book.modify_ask_order(ask1.get(), 20000, 100, 1100));
+  CHECK_FALSE(order_book.modify_ask_order(ask1.get(), 15005, 100, 1100));
+  CHECK(ask1->price == 15000);
+  CHECK(order_book.asks_size() == 1);
+  CHECK(order_book.modify_ask_order(ask1.get(), 15010, 100, 1100));
+  REQUIRE(order_book.get_best_ask_order() != nullptr);
+  CHECK(order_book.get_best_ask_order()->price == 15010);
+}
+
+TEST_CASE_TEMPLATE("market_order_sweeps_book", Book, OrderBook, HeapOrderBook,
+                   FlatOrderBook) {
+  Book order_book;
+
+  auto ask1 = std::make_unique<LimitOrder>(1, 1000, 10000, 100);
+  auto ask2 = std::make_unique<LimitOrder>(2, 1100, 10500, 100);
+  auto ask3 = std::make_unique<LimitOrder>(3, 1200, 10900, 100);
+  order_book.add_ask_order(ask1.get());
+  order_book.add_ask_order(ask2.get());
+  order_book.add_ask_order(ask3.get());
+
+  auto bid1 = std::make_unique<LimitOrder>(4, 1300, 0, 150);
+  order_book.add_market_bid_order(bid1.get());
+  CHECK(bid1->filled_quantity == 150);
+  CHECK_FALSE(bid1->is_cancelled);
+  CHECK(bid1->balance == -100 * 10000 - 50 * 10500);
+  CHECK(ask2->filled_quantity == 50);
+
+  // The leftover is cancelled rather than resting at a nonsense price.
+  auto bid2 = std::make_unique<LimitOrder>(5, 1400, 0, 500);
+  order_book.add_market_bid_order(bid2.get());
+  CHECK(bid2->filled_quantity == 150);
+  CHECK(bid2->is_cancelled);
+  CHECK(bid2->level == nullptr);
+  CHECK(order_book.asks_size() == 0);
+  CHECK(order_book.bids_size() == 0);
+
+  auto ask4 = std::make_unique<LimitOrder>(6, 1500, 0, 10);
+  order_book.add_market_ask_order(ask4.get());
+  CHECK(ask4->filled_quantity == 0);
+  CHECK(ask4->is_cancelled);
+}
+
+TEST_CASE("market_order_protection_band") {
+  OrderBook order_book;
+
+  auto bid1 = std::make_unique<LimitOrder>(1, 1000, 10000, 100);
+  auto bid2 = std::make_unique<LimitOrder>(2, 1100, 9950, 100);
+  auto bid3 = std::make_unique<LimitOrder>(3, 1200, 9900, 100);
+  order_book.add_bid_order(bid1.get());
+  order_book.add_bid_order(bid2.get());
+  order_book.add_bid_order(bid3.get());
+
+  auto ask1 = std::make_unique<LimitOrder>(4, 1300, 0, 300);
+  order_book.add_market_ask_order(ask1.get(), 50);
+  CHECK(ask1->price == 9950);
+  CHECK(ask1->filled_quantity == 200);
+  CHECK(ask1->is_cancelled);
+  CHECK(order_book.asks_size() == 0);
+  REQUIRE(order_book.get_best_bid_order() != nullptr);
+  CHECK(order_book.get_best_bid_order()->id == 3);
+
+  // The band saturates at the ends of the price range.
+  auto ask2 = std::make_unique<LimitOrder>(5, 1400, 0, 50);
+  order_book.add_market_ask_order(ask2.get(), 20000);
+  CHECK(ask2->price == 0);
+  CHECK(ask2->filled_quantity == 50);
+  CHECK_FALSE(ask2->is_cancelled);
+
+  auto bid4 = std::make_unique<LimitOrder>(6, 1500, 0, 50);
+  order_book.add_market_bid_order(bid4.get(), 10);
+  CHECK(bid4->filled_quantity == 0);
+  CHECK(bid4->is_cancelled);
+}
+
+TEST_CASE("ioc_order_never_rests") {
+  OrderBook order_book;
+
+  auto ask1 = std::make_unique<LimitOrder>(1, 1000, 10000, 100);
+  auto ask2 = std::make_unique<LimitOrder>(2, 1100, 10100, 100);
+  order_book.add_ask_order(ask1.get());
+  order_book.add_ask_order(ask2.get());
+
+  auto bid1 = std::make_unique<LimitOrder>(3, 1200, 10000, 150);
+  order_book.add_ioc_bid_order(bid1.get());
+  CHECK(bid1->filled_quantity == 100);
+  CHECK(bid1->is_cancelled);
+  CHECK(bid1->level == nullptr);
+  CHECK(order_book.bids_size() == 0);
+  CHECK(ask2->filled_quantity == 0);
+
+  auto bid2 = std::make_unique<LimitOrder>(4, 1300, 10100, 60);
+  order_book.add_ioc_bid_order(bid2.get());
+  CHECK(bid2->filled_quantity == 60);
+  CHECK_FALSE(bid2->is_cancelled);
+
+  auto ask3 = std::make_unique<LimitOrder>(5, 1400, 10000, 10);
+  order_book.add_ioc_ask_order(ask3.get());
+  CHECK(ask3->filled_quantity == 0);
+  CHECK(ask3->is_cancelled);
+  CHECK(order_book.asks_size() == 1);
+}
+
+TEST_CASE_TEMPLATE("fok_order_fills_completely_or_not_at_all", Book,
+                   OrderBook, HeapOrderBook, FlatOrderBook) {
+  Book order_book;
+
+  auto bid1 = std::make_unique<LimitOrder>(1, 1000, 10000, 100);
+  auto bid2 = std::make_unique<LimitOrder>(2, 1100, 9900, 100);
+  auto bid3 = std::make_unique<LimitOrder>(3, 1200, 9800, 100);
+  order_book.add_bid_order(bid1.get());
+  order_book.add_bid_order(bid2.get());
+  order_book.add_bid_order(bid3.get());
+
+  // 250 is only available down to 9800, the order is killed untouched.
+  auto ask1 = std::make_unique<LimitOrder>(4, 1300, 9900, 250);
+  order_book.add_fok_ask_order(ask1.get());
+  CHECK(ask1->is_cancelled);
+  CHECK(ask1->filled_quantity == 0);
+  CHECK(ask1->balance == 0);
+  CHECK(bid1->filled_quantity == 0);
+  CHECK(bid2->filled_quantity == 0);
+  CHECK(order_book.bids_size() == 3);
+  CHECK(order_book.asks_size() == 0);
+
+  auto ask2 = std::make_unique<LimitOrder>(5, 1400, 9800, 250);
+  order_book.add_fok_ask_order(ask2.get());
+  CHECK_FALSE(ask2->is_cancelled);
+  CHECK(ask2->filled_quantity == 250);
+  CHECK(ask2->balance == 100 * 10000 + 100 * 9900 + 50 * 9800);
+  CHECK(order_book.bids_size() == 1);
+
+  auto ask3 = std::make_unique<LimitOrder>(6, 1500, 9800, 50);
+  order_book.add_fok_ask_order(ask3.get());
+  CHECK(ask3->filled_quantity == 50);
+  CHECK(order_book.bids_size() == 0);
+
+  auto bid4 = std::make_unique<LimitOrder>(7, 1600, 20000, 1);
+  order_book.add_fok_bid_order(bid4.get());
+  CHECK(bid4->is_cancelled);
+  CHECK(order_book.bids_size() == 0);
+}
+
+TEST_CASE("post_only_order_rejects_or_slides") {
+  OrderBook order_book;
+  CHECK(order_book.get_tick_size() == 1);
+
+  auto bid1 = std::make_unique<LimitOrder>(1, 1000, 9900, 100);
+  auto ask1 = std::make_unique<LimitOrder>(2, 1100, 10000, 100);
+  order_book.add_bid_order(bid1.get());
+  order_book.add_ask_order(ask1.get());
+
+  auto bid2 = std::make_unique<LimitOrder>(3, 1200, 9950, 50);
+  order_book.add_post_only_bid_order(bid2.get(), LimitOrder::PostOnly::Reject);
+  CHECK_FALSE(bid2->is_cancelled);
+  CHECK(bid2->level != nullptr);
+  CHECK(order_book.get_best_bid_level()->price == 9950);
+
+  auto bid3 = std::make_unique<LimitOrder>(4, 1300, 10000, 50);
+  order_book.add_post_only_bid_order(bid3.get(), LimitOrder::PostOnly::Reject);
+  CHECK(bid3->is_cancelled);
+  CHECK(bid3->filled_quantity == 0);
+  CHECK(ask1->filled_quantity == 0);
+  CHECK(order_book.bids_size() == 2);
+
+  auto bid4 = std::make_unique<LimitOrder>(5, 1400, 10200, 50);
+  order_book.add_post_only_bid_order(bid4.get(), LimitOrder::PostOnly::Slide);
+  CHECK_FALSE(bid4->is_cancelled);
+  CHECK(bid4->filled_quantity == 0);
+  CHECK(bid4->price == 9999);
+  CHECK(order_book.get_best_bid_order() == bid4.get());
+  CHECK(ask1->filled_quantity == 0);
+
+  auto ask2 = std::make_unique<LimitOrder>(6, 1500, 9000, 50);
+  order_book.add_post_only_ask_order(ask2.get(), LimitOrder::PostOnly::Slide);
+  CHECK(ask2->price == 10000);
+  CHECK(ask2->filled_quantity == 0);
+  CHECK(order_book.get_best_ask_level()->order_count == 2);
+}
+
+TEST_CASE("post_only_order_slides_by_the_configured_tick") {
+  DenseOrderBook order_book{{14000, 10, 200}};
+  CHECK(order_book.get_tick_size() == 10);
+
+  auto bid1 = std::make_unique<LimitOrder>(1, 1000, 14000, 100);
+  order_book.add_bid_order(bid1.get());
+
+  auto ask1 = std::make_unique<LimitOrder>(2, 1100, 14000, 100);
+  order_book.add_post_only_ask_order(ask1.get(), LimitOrder::PostOnly::Slide);
+  CHECK(ask1->price == 14010);
+  CHECK(order_book.get_best_ask_level()->price == 14010);
+
+  // One tick below the best ask is outside the band.
+  DenseOrderBook edge_book{{14000, 10, 200}};
+  auto ask2 = std::make_unique<LimitOrder>(3, 1200, 14000, 100);
+  edge_book.add_ask_order(ask2.get());
+  auto bid2 = std::make_unique<LimitOrder>(4, 1300, 14000, 100);
+  edge_book.add_post_only_bid_order(bid2.get(), LimitOrder::PostOnly::Slide);
+  CHECK(bid2->is_cancelled);
+  CHECK(edge_book.bids_size() == 0);
+  CHECK(ask2->filled_quantity == 0);
+}
+
+TEST_CASE("hybrid_order_book_sweeps_near_max_price") {
+  constexpr price_t max_price{std::numeric_limits<price_t>::max()};
+  HybridOrderBook order_book{{1, 64}};
+  std::vector<std::unique_ptr<LimitOrder>> asks;
+  for (price_t i = 0; i < 10; ++i) {
+    asks.push_back(std::make_unique<LimitOrder>(i, i, max_price - i, 10));
+    order_book.add_ask_order(asks.back().get());
+  }
+  auto far_ask = std::make_unique<LimitOrder>(10, 10, 1000, 10);
+  order_book.add_ask_order(far_ask.get());
+  CHECK(order_book.ask_levels_size() == 11);
+
+  auto bid = std::make_unique<LimitOrder>(11, 11, max_price, 110);
+  order_book.add_bid_order(bid.get());
+  CHECK(bid->filled_quantity == 110);
+  CHECK(order_book.asks_size() == 0);
+  CHECK(order_book.ask_levels_size() == 0);
+  for (const auto &ask : asks) {
+    CHECK(ask->filled_quantity == 10);
+  }
+}
+
 TEST_SUITE_END();
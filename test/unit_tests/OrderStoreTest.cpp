@@ -0,0 +1,167 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/LimitOrder.h"
+#include "clob/OrderStore.h"
+
+TEST_SUITE_BEGIN("OrderStore");
+
+using namespace clob;
+
+/***/
+TEST_CASE("order_store_create") {
+  OrderStore store;
+  CHECK(store.size() == 0);
+  CHECK(store.num_chunks() == 0);
+
+  LimitOrder *order1 =
+      store.create(3, LimitOrder::OrderType::Bid, 1000, 7, 15000, 100);
+  LimitOrder *order2 =
+      store.create(5, LimitOrder::OrderType::Ask, 2000, 8, 15100, 50);
+  CHECK(store.size() == 2);
+  CHECK(store.num_chunks() == 1);
+  CHECK(order1->id == 0);
+  CHECK(order2->id == 1);
+  CHECK(store.get(0) == order1);
+  CHECK(store.get(1) == order2);
+  CHECK(order2->sequence == 8);
+  CHECK(store.timestamp(1) == 2000);
+  CHECK(order2->price == 15100);
+  CHECK(order2->quantity == 50);
+  CHECK(order2->level == nullptr);
+  CHECK(store.stock_id(0) == 3);
+  CHECK(store.stock_id(1) == 5);
+  CHECK(store.order_type(0) == LimitOrder::OrderType::Bid);
+  CHECK(store.order_type(1) == LimitOrder::OrderType::Ask);
+}
+
+/***/
+TEST_CASE("order_store_records_never_move") {
+  OrderStore store;
+  std::vector<LimitOrder *> created;
+  const std::size_t n = 3 * OrderStore::chunk_size + 1;
+  for (std::size_t i = 0; i < n; ++i) {
+    created.push_back(
+        store.create(0, LimitOrder::OrderType::Bid, i, i, 100, 1));
+  }
+  CHECK(store.num_chunks() == 4);
+  bool same{true};
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto handle = static_cast<OrderStore::handle_t>(i);
+    same = same && store.get(handle) == created[i] &&
+           created[i]->id == i && created[i]->sequence == i &&
+           store.timestamp(handle) == i;
+  }
+  CHECK(same);
+  CHECK(reinterpret_cast<std::uintptr_t>(created[0]) % alignof(LimitOrder) ==
+        0);
+}
+
+/***/
+TEST_CASE("order_store_for_each_live_order") {
+  OrderStore store;
+  for (std::uint32_t i = 0; i < 10; ++i) {
+    store.create(i % 3, LimitOrder::OrderType::Bid, i, i, 100, 1);
+  }
+  CHECK(store.is_live(4));
+  store.set_terminal(4, 100);
+  CHECK_FALSE(store.is_live(4));
+
+  std::vector<OrderStore::handle_t> handles;
+  const auto collect = [&](const OrderStore::handle_t handle) {
+    handles.push_back(handle);
+  };
+  store.for_each_live_order(1, collect);
+  CHECK(handles == std::vector<OrderStore::handle_t>{1, 7});
+  handles.clear();
+  store.for_each_live_order(7, collect);
+  CHECK(handles.empty());
+
+  store.reuse(4, 1, LimitOrder::OrderType::Ask, 10, 10, 100, 1);
+  CHECK(store.is_live(4));
+  store.for_each_live_order(1, collect);
+  CHECK(handles == std::vector<OrderStore::handle_t>{1, 4, 7});
+}
+
+/***/
+TEST_CASE("order_store_tracks_live_orders_per_chunk") {
+  OrderStore store;
+  for (std::uint32_t i = 0; i < OrderStore::chunk_size + 2; ++i) {
+    store.create(0, LimitOrder::OrderType::Bid, i, i, 100, 1);
+  }
+  CHECK(store.num_live(0) == OrderStore::chunk_size);
+  CHECK(store.num_live(1) == 2);
+  CHECK(store.last_terminal(0) == 0);
+
+  store.set_terminal(3, 500);
+  store.set_terminal(5, 400);
+  store.set_terminal(5, 900);
+  CHECK(store.num_live(0) == OrderStore::chunk_size - 2);
+  CHECK(store.last_terminal(0) == 500);
+  CHECK(store.num_live(1) == 2);
+
+  store.reuse(3, 0, LimitOrder::OrderType::Bid, 600, 600, 100, 1);
+  CHECK(store.num_live(0) == OrderStore::chunk_size - 1);
+  store.reuse(3, 0, LimitOrder::OrderType::Bid, 700, 700, 100, 1);
+  CHECK(store.num_live(0) == OrderStore::chunk_size - 1);
+}
+
+/***/
+TEST_CASE("order_store_reuse") {
+  OrderStore store;
+  LimitOrder *order =
+      store.create(3, LimitOrder::OrderType::Bid, 1000, 0, 100, 5);
+  store.create(3, LimitOrder::OrderType::Bid, 1000, 1, 100, 5);
+  order->filled_quantity = 5;
+
+  LimitOrder *reused =
+      store.reuse(0, 4, LimitOrder::OrderType::Ask, 2000, 2, 101, 7);
+  CHECK(reused == order);
+  CHECK(reused->id == (LimitOrder::id_t{1} << 32));
+  CHECK(reused->filled_quantity == 0);
+  CHECK(reused->quantity == 7);
+  CHECK(reused->sequence == 2);
+  CHECK(store.timestamp(0) == 2000);
+  CHECK(store.stock_id(0) == 4);
+  CHECK(store.order_type(0) == LimitOrder::OrderType::Ask);
+  CHECK(store.size() == 2);
+  CHECK(OrderStore::handle_of(reused->id) == 0);
+
+  reused = store.reuse(0, 4, LimitOrder::OrderType::Ask, 3000, 3, 101, 7);
+  CHECK(reused->id == (LimitOrder::id_t{2} << 32));
+  CHECK(store.get(1)->id == 1);
+}
+
+/***/
+TEST_CASE("order_store_release_chunk") {
+  OrderStore store;
+  const std::size_t n = 2 * OrderStore::chunk_size + 1;
+  for (std::size_t i = 0; i < n; ++i) {
+    store.create(i % 2, LimitOrder::OrderType::Bid, i, i, 100, 1);
+  }
+  CHECK(store.num_resident_chunks() == 3);
+
+  store.release_chunk(0);
+  store.release_chunk(0);
+  CHECK(store.size() == n);
+  CHECK(store.num_chunks() == 3);
+  CHECK(store.num_resident_chunks() == 2);
+  CHECK_FALSE(store.is_resident(0));
+  CHECK_FALSE(store.is_resident(OrderStore::chunk_size - 1));
+  CHECK(store.is_resident(OrderStore::chunk_size));
+  CHECK(store.get(OrderStore::chunk_size)->id == OrderStore::chunk_size);
+
+  std::vector<OrderStore::handle_t> handles;
+  store.for_each_live_order(0, [&](const OrderStore::handle_t handle) {
+    handles.push_back(handle);
+  });
+  CHECK(handles.size() == OrderStore::chunk_size / 2 + 1);
+  CHECK(handles.front() == OrderStore::chunk_size);
+  CHECK(handles.back() == 2 * OrderStore::chunk_size);
+}
+
+TEST_SUITE_END();
\ No newline at end of file
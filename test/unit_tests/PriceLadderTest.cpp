@@ -0,0 +1,209 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/LimitOrder.h"
+#include "clob/PriceLadder.h"
+#include "clob/PriceLevel.h"
+
+TEST_SUITE_BEGIN("PriceLadder");
+
+using namespace clob;
+
+/***/
+TEST_CASE("price_level_construction") {
+  PriceLevel level{15000};
+
+  CHECK(level.price == 15000);
+  CHECK(level.empty());
+  CHECK(level.front() == nullptr);
+  CHECK_FALSE(std::is_copy_constructible_v<PriceLevel>);
+  CHECK_FALSE(std::is_copy_assignable_v<PriceLevel>);
+}
+
+/***/
+TEST_CASE("price_level_fifo") {
+  PriceLevel level{15000};
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15000, 100};
+  LimitOrder order3{3, 3000, 15000, 100};
+
+  level.push_back(&order1);
+  level.push_back(&order2);
+  level.push_back(&order3);
+  REQUIRE(level.front() == &order1);
+  CHECK(level.tail == &order3);
+
+  level.pop_front();
+  CHECK(level.front() == &order2);
+  CHECK(order1.next == nullptr);
+  CHECK(order1.level == nullptr);
+  CHECK(order2.prev == nullptr);
+  level.pop_front();
+  CHECK(level.front() == &order3);
+  level.pop_front();
+  CHECK(level.empty());
+  CHECK(level.tail == nullptr);
+}
+
+/***/
+TEST_CASE("price_level_appends_without_comparing_sequences") {
+  PriceLevel level{15000};
+  LimitOrder order1{1, 2000, 15000, 100};
+  LimitOrder order2{2, 4000, 15000, 100};
+  LimitOrder order3{3, 1000, 15000, 100};
+
+  level.push_back(&order1);
+  level.push_back(&order2);
+  level.push_back(&order3);
+
+  REQUIRE(level.front() == &order1);
+  CHECK(order1.next == &order2);
+  CHECK(order2.next == &order3);
+  CHECK(order3.next == nullptr);
+  CHECK(order3.prev == &order2);
+  CHECK(level.tail == &order3);
+  CHECK(level.order_count == 3);
+}
+
+/***/
+TEST_CASE("price_ladder_bid_ordering") {
+  PriceLadder<LimitOrder::OrderType::Bid> ladder;
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15100, 100};
+  LimitOrder order3{3, 3000, 15000, 100};
+
+  CHECK(ladder.empty());
+  CHECK(ladder.best_level() == nullptr);
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+  CHECK(ladder.size() == 3);
+  CHECK(ladder.num_levels() == 2);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 15100);
+
+  ladder.pop();
+  CHECK(ladder.size() == 2);
+  CHECK(ladder.num_levels() == 1);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->front() == &order1);
+
+  ladder.pop();
+  CHECK(ladder.best_level()->front() == &order3);
+  ladder.pop();
+  CHECK(ladder.empty());
+  CHECK(ladder.num_levels() == 0);
+}
+
+/***/
+TEST_CASE("price_ladder_ask_ordering") {
+  PriceLadder<LimitOrder::OrderType::Ask> ladder;
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 14900, 100};
+  LimitOrder order3{3, 3000, 15100, 100};
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+  CHECK(ladder.num_levels() == 3);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->price == 14900);
+
+  ladder.pop();
+  CHECK(ladder.best_level()->price == 15000);
+  ladder.pop();
+  CHECK(ladder.best_level()->price == 15100);
+}
+
+/***/
+TEST_CASE("price_ladder_erase") {
+  PriceLadder<LimitOrder::OrderType::Ask> ladder;
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15000, 100};
+  LimitOrder order3{3, 3000, 15100, 100};
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+  CHECK(order1.level == ladder.best_level());
+
+  ladder.erase(&order3);
+  CHECK(ladder.size() == 2);
+  CHECK(ladder.num_levels() == 1);
+  CHECK(order3.level == nullptr);
+
+  ladder.erase(&order1);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->front() == &order2);
+  CHECK(order2.prev == nullptr);
+
+  ladder.erase(&order2);
+  CHECK(ladder.empty());
+  CHECK(ladder.num_levels() == 0);
+}
+
+/***/
+TEST_CASE("price_level_aggregates") {
+  PriceLevel level{15000};
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15000, 50};
+  order2.filled_quantity = 20;
+
+  CHECK(level.total_quantity == 0);
+  CHECK(level.order_count == 0);
+  level.push_back(&order1);
+  level.push_back(&order2);
+  CHECK(level.total_quantity == 130);
+  CHECK(level.order_count == 2);
+
+  level.fill(&order1, 40);
+  CHECK(order1.filled_quantity == 40);
+  CHECK(level.total_quantity == 90);
+
+  level.reduce(&order1, 10);
+  CHECK(order1.quantity == 90);
+  CHECK(level.total_quantity == 80);
+
+  level.erase(&order2);
+  CHECK(level.total_quantity == 50);
+  CHECK(level.order_count == 1);
+
+  level.fill(&order1, 50);
+  level.pop_front();
+  CHECK(level.total_quantity == 0);
+  CHECK(level.order_count == 0);
+}
+
+/***/
+TEST_CASE("price_ladder_pop_level") {
+  PriceLadder<LimitOrder::OrderType::Ask> ladder;
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15000, 100};
+  LimitOrder order3{3, 3000, 15100, 100};
+
+  ladder.push(&order1);
+  ladder.push(&order2);
+  ladder.push(&order3);
+
+  std::vector<LimitOrder *> drained;
+  ladder.pop_level([&](LimitOrder *order) {
+    CHECK(order->level == nullptr);
+    CHECK(order->next == nullptr);
+    drained.push_back(order);
+  });
+  CHECK(drained == std::vector<LimitOrder *>{&order1, &order2});
+  CHECK(ladder.size() == 1);
+  CHECK(ladder.num_levels() == 1);
+  REQUIRE(ladder.best_level() != nullptr);
+  CHECK(ladder.best_level()->front() == &order3);
+}
+
+TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/LimitOrder.h"
+#include "clob/OrderBook.h"
+#include "clob/PriceLevel.h"
+#include "clob/ProRataPriority.h"
+
+TEST_SUITE_BEGIN("ProRataPriority");
+
+using namespace clob;
+
+namespace {
+
+using fills_t = std::vector<std::pair<LimitOrder::id_t, quantity_t>>;
+
+template <typename Policy>
+fills_t match(Policy &policy, PriceLevel &level, const quantity_t quantity,
+              quantity_t &allocated) {
+  fills_t fills;
+  allocated = policy.match(level, quantity,
+                           [&](LimitOrder *order, const quantity_t share) {
+                             fills.emplace_back(order->id, share);
+                           });
+  return fills;
+}
+
+} // namespace
+
+/***/
+TEST_CASE("pro_rata_allocator_shares") {
+  PriceLevel level{15000};
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15000, 300};
+  LimitOrder order3{3, 3000, 15000, 600};
+  level.push_back(&order1);
+  level.push_back(&order2);
+  level.push_back(&order3);
+
+  ProRataAllocator allocator;
+  allocator.gather(level);
+  CHECK(allocator.allocate_pro_rata(500, 1) == 500);
+  fills_t fills;
+  allocator.fill([&](LimitOrder *order, const quantity_t share) {
+    fills.emplace_back(order->id, share);
+  });
+  CHECK(fills == fills_t{{1, 50}, {2, 150}, {3, 300}});
+}
+
+/***/
+TEST_CASE("pro_rata_without_top_order") {
+  PriceLevel level{15000};
+  LimitOrder order1{1, 1000, 15000, 10};
+  LimitOrder order2{2, 2000, 15000, 30};
+  LimitOrder order3{3, 3000, 15000, 60};
+  level.push_back(&order1);
+  level.push_back(&order2);
+  level.push_back(&order3);
+
+  ProRataPriority<false> policy;
+  quantity_t allocated;
+  const fills_t fills = match(policy, level, 55, allocated);
+  CHECK(allocated == 55);
+  // 5.5, 16.5 and 33 round down to 5, 16 and 33; the last unit goes FIFO.
+  CHECK(fills == fills_t{{1, 6}, {2, 16}, {3, 33}});
+}
+
+/***/
+TEST_CASE("pro_rata_top_order_and_min_allocation") {
+  PriceLevel level{15000};
+  LimitOrder order1{1, 1000, 15000, 20};
+  LimitOrder order2{2, 2000, 15000, 10};
+  LimitOrder order3{3, 3000, 15000, 200};
+  level.push_back(&order1);
+  level.push_back(&order2);
+  level.push_back(&order3);
+
+  ProRataPriority<true, 5> policy;
+  quantity_t allocated;
+  const fills_t fills = match(policy, level, 60, allocated);
+  CHECK(allocated == 60);
+  // The top order takes 20, then 40 of 210 is shared: order2's 1.9 is below
+  // the minimum and order3 takes 38. The 2 left over go FIFO to order2.
+  CHECK(fills == fills_t{{1, 20}, {2, 2}, {3, 38}});
+}
+
+/***/
+TEST_CASE("pro_rata_skips_unlinked_orders") {
+  PriceLevel level{15000};
+  LimitOrder order1{1, 1000, 15000, 100};
+  LimitOrder order2{2, 2000, 15000, 100};
+  level.push_back(&order1);
+  level.push_back(&order2);
+  level.erase(&order1);
+
+  ProRataPriority<> policy;
+  quantity_t allocated;
+  const fills_t fills = match(policy, level, 40, allocated);
+  CHECK(allocated == 40);
+  CHECK(fills == fills_t{{2, 40}});
+}
+
+/***/
+TEST_CASE("fifo_pro_rata_split") {
+  PriceLevel level{15000};
+  LimitOrder order1{1, 1000, 15000, 30};
+  LimitOrder order2{2, 2000, 15000, 50};
+  LimitOrder order3{3, 3000, 15000, 100};
+  level.push_back(&order1);
+  level.push_back(&order2);
+  level.push_back(&order3);
+
+  FifoProRataPriority<40> policy;
+  quantity_t allocated;
+  const fills_t fills = match(policy, level, 100, allocated);
+  CHECK(allocated == 100);
+  // 40 go FIFO: 30 to order1 and 10 to order2. 60 of the remaining 140 are
+  // shared: 17.1 and 42.8 round down to 17 and 42, the last unit goes FIFO.
+  CHECK(fills == fills_t{{1, 30}, {2, 28}, {3, 42}});
+}
+
+/***/
+TEST_CASE("pro_rata_order_book") {
+  ProRataOrderBook order_book;
+
+  auto ask1 = std::make_unique<LimitOrder>(1, 1000, 15000, 100);
+  auto ask2 = std::make_unique<LimitOrder>(2, 1100, 15000, 100);
+  auto ask3 = std::make_unique<LimitOrder>(3, 1200, 15000, 200);
+  auto ask4 = std::make_unique<LimitOrder>(4, 1300, 15100, 100);
+  order_book.add_ask_order(ask1.get());
+  order_book.add_ask_order(ask2.get());
+  order_book.add_ask_order(ask3.get());
+  order_book.add_ask_order(ask4.get());
+
+  auto bid1 = std::make_unique<LimitOrder>(5, 1400, 15100, 200);
+  order_book.add_bid_order(bid1.get());
+  CHECK(bid1->filled_quantity == 200);
+  CHECK(bid1->balance == -200 * 15000);
+  CHECK(ask1->filled_quantity == 100);
+  // 100 of 300 shared rounds down to 33 and 66, the last unit goes FIFO.
+  CHECK(ask2->filled_quantity == 34);
+  CHECK(ask3->filled_quantity == 66);
+  CHECK(ask2->balance == 34 * 15000);
+  CHECK(order_book.asks_size() == 3);
+  CHECK(order_book.get_best_ask_level()->total_quantity == 200);
+
+  auto bid2 = std::make_unique<LimitOrder>(6, 1500, 15100, 250);
+  order_book.add_bid_order(bid2.get());
+  CHECK(bid2->filled_quantity == 250);
+  CHECK(ask2->filled_quantity == 100);
+  CHECK(ask3->filled_quantity == 200);
+  CHECK(ask4->filled_quantity == 50);
+  CHECK(order_book.asks_size() == 1);
+  CHECK(order_book.ask_levels_size() == 1);
+}
+
+TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "doctest/doctest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/ReferenceFile.h"
+
+TEST_SUITE_BEGIN("ReferenceFile");
+
+using namespace clob;
+
+namespace {
+
+std::string reference_path(const char *name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void write_text(const std::string &path, const std::string &text) {
+  std::ofstream{path, std::ios::binary} << text;
+}
+
+} // namespace
+
+/***/
+TEST_CASE("reference_file_missing") {
+  ReferenceFile file;
+  CHECK_FALSE(file.open(reference_path("clob_reference_missing.csv")));
+  CHECK(file.size() == 0);
+}
+
+/***/
+TEST_CASE("reference_file_csv") {
+  const std::string path = reference_path("clob_reference.csv");
+  write_text(path, "name,ticker,tick_size,lot_size\r\n"
+                   "Apple,AAPL,1,100\r\n"
+                   "\r\n"
+                   "Alphabet,GOOGL,5,10\n"
+                   "Microsoft,MSFT,2,1");
+  ReferenceFile file;
+  REQUIRE(file.open(path));
+  CHECK(file.size() == 3);
+
+  ReferenceRecord record;
+  REQUIRE(file.read(record));
+  CHECK(record.name == "Apple");
+  CHECK(record.ticker == "AAPL");
+  CHECK(record.tick_size == 1);
+  CHECK(record.lot_size == 100);
+  REQUIRE(file.read(record));
+  CHECK(record.ticker == "GOOGL");
+  CHECK(record.tick_size == 5);
+  REQUIRE(file.read(record));
+  CHECK(record.name == "Microsoft");
+  CHECK(record.lot_size == 1);
+  CHECK(file.at_end());
+  CHECK_FALSE(file.read(record));
+  std::filesystem::remove(path);
+}
+
+/***/
+TEST_CASE("reference_file_csv_malformed") {
+  const std::string path = reference_path("clob_reference_malformed.csv");
+  for (const char *line :
+       {"Apple,AAPL,1\n", "Apple,AAPL,x,100\n", "Apple,AAPL,1,100,7\n",
+        "Apple,AAPL,0,100\n", "Apple,AAPL,-1,100\n"}) {
+    write_text(path, std::string{"Alphabet,GOOGL,5,10\n"} + line);
+    ReferenceFile file;
+    REQUIRE(file.open(path));
+    ReferenceRecord record;
+    CHECK(file.read(record));
+    CHECK_FALSE(file.read(record));
+    CHECK_FALSE(file.at_end());
+  }
+  std::filesystem::remove(path);
+}
+
+/***/
+TEST_CASE("reference_file_binary") {
+  const std::string path = reference_path("clob_reference.bin");
+  const std::vector<ReferenceRecord> records{
+      {"Apple", "AAPL", 1, 100},
+      {"Alphabet", "GOOGL", 5, 10},
+      {"Eight", "ABCDEFGH", 2, 1},
+      {"", "X", 1, 1}};
+  REQUIRE(ReferenceFile::write(path, records));
+
+  ReferenceFile file;
+  REQUIRE(file.open(path));
+  CHECK(file.size() == records.size());
+  ReferenceRecord record;
+  for (const ReferenceRecord &expected : records) {
+    REQUIRE(file.read(record));
+    CHECK(record.name == expected.name);
+    CHECK(record.ticker == expected.ticker);
+    CHECK(record.tick_size == expected.tick_size);
+    CHECK(record.lot_size == expected.lot_size);
+  }
+  CHECK(file.at_end());
+  CHECK_FALSE(file.read(record));
+
+  const std::vector<ReferenceRecord> too_long{{"Nine", "ABCDEFGHI", 1, 1}};
+  CHECK_FALSE(ReferenceFile::write(path, too_long));
+  std::filesystem::remove(path);
+}
+
+/***/
+TEST_CASE("reference_file_binary_truncated") {
+  const std::string path = reference_path("clob_reference_truncated.bin");
+  const std::vector<ReferenceRecord> records{{"Apple", "AAPL", 1, 100},
+                                             {"Alphabet", "GOOGL", 5, 10}};
+  REQUIRE(ReferenceFile::write(path, records));
+  // Cut the second name short, then the second record.
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+
+  ReferenceFile file;
+  REQUIRE(file.open(path));
+  ReferenceRecord record;
+  CHECK(file.read(record));
+  CHECK_FALSE(file.read(record));
+  CHECK_FALSE(file.at_end());
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 20);
+  CHECK_FALSE(file.open(path));
+  std::filesystem::remove(path);
+}
+
+TEST_SUITE_END();
\ No newline at end of file
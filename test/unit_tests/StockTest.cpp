@@ -1,12 +1,14 @@
 #include "doctest/doctest.h"
 
 #include <cstdint>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
 #include "misc/TestUtilities.h"
 
 #include "clob/Stock.h"
+#include "clob/TickerIndex.h"
 
 TEST_SUITE_BEGIN("Stock");
 
@@ -56,6 +58,19 @@ TEST_CASE("stock_types") {
 
   CHECK(std::is_same_v<decltype(stock.id), const Stock::id_t>);
   CHECK(sizeof(stock.id) >= sizeof(int32_t));
+  CHECK(std::is_same_v<decltype(stock.name), const std::string_view>);
+  CHECK(std::is_same_v<decltype(stock.ticker), const std::string_view>);
+}
+
+/***/
+TEST_CASE("stock_ticker_code") {
+  Stock stock{"stock", "AAPL", 2, 5, 100};
+  CHECK(stock.ticker_code == TickerIndex::pack("AAPL"));
+  CHECK(stock.tick_size == 5);
+  CHECK(stock.lot_size == 100);
+  Stock long_ticker{"stock", "TOOLONGTK", 3};
+  CHECK(long_ticker.ticker_code == 0);
+  CHECK(long_ticker.ticker == "TOOLONGTK");
 }
 
 /***/
@@ -0,0 +1,64 @@
+#include "doctest/doctest.h"
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/StringArena.h"
+
+TEST_SUITE_BEGIN("StringArena");
+
+using namespace clob;
+
+/***/
+TEST_CASE("string_arena_append") {
+  StringArena strings;
+  CHECK(strings.size() == 0);
+  CHECK(strings.num_blocks() == 0);
+
+  std::string text{"Apple Inc. Common Stock"};
+  const std::string_view apple = strings.append(text);
+  CHECK(apple == text);
+  CHECK(apple.data() != text.data());
+  text.assign(text.size(), 'x');
+  CHECK(apple == "Apple Inc. Common Stock");
+
+  const std::string_view ticker = strings.append("AAPL");
+  CHECK(ticker.data() == apple.data() + apple.size());
+  CHECK(strings.append("").empty());
+  CHECK(strings.size() == 3);
+  CHECK(strings.size_bytes() == apple.size() + ticker.size());
+  CHECK(strings.num_blocks() == 1);
+}
+
+/***/
+TEST_CASE("string_arena_blocks") {
+  StringArena strings;
+  const std::string large(100000, 'a');
+  const std::string_view first = strings.append("first");
+  CHECK(strings.append(large) == large);
+  CHECK(strings.num_blocks() == 2);
+  CHECK(first == "first");
+
+  strings.reserve(50000);
+  const std::size_t num_blocks = strings.num_blocks();
+  for (int i = 0; i < 1000; ++i) {
+    strings.append("string" + std::to_string(i));
+  }
+  CHECK(strings.num_blocks() == num_blocks);
+  CHECK(strings.append("string999") == "string999");
+}
+
+/***/
+TEST_CASE("string_arena_memory_resource") {
+  std::pmr::monotonic_buffer_resource resource;
+  {
+    StringArena strings{&resource};
+    CHECK(strings.append("MSFT") == "MSFT");
+  }
+  resource.release();
+}
+
+TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "misc/TestUtilities.h"
+
+#include "clob/TickerIndex.h"
+
+TEST_SUITE_BEGIN("TickerIndex");
+
+using namespace clob;
+
+namespace {
+
+std::string make_ticker(std::size_t i) {
+  std::string ticker;
+  do {
+    ticker.push_back(static_cast<char>('A' + i % 26));
+    i /= 26;
+  } while (i != 0);
+  return ticker;
+}
+
+} // namespace
+
+/***/
+TEST_CASE("ticker_index_pack") {
+  CHECK(TickerIndex::pack("A") == 'A');
+  CHECK(TickerIndex::pack("AB") == ('A' | ('B' << 8)));
+  CHECK(TickerIndex::pack("ABCDEFGH") != 0);
+  CHECK(TickerIndex::pack("ABCDEFGH") != TickerIndex::pack("ABCDEFG"));
+  CHECK(TickerIndex::pack("") == 0);
+  CHECK(TickerIndex::pack("ABCDEFGHI") == 0);
+  CHECK(TickerIndex::pack(std::string("A\0B", 3)) == 0);
+  static_assert(TickerIndex::pack("AAPL") != 0);
+}
+
+/***/
+TEST_CASE("ticker_index_insert_find") {
+  TickerIndex index;
+  TickerIndex::value_t value{0};
+  CHECK_FALSE(index.find(TickerIndex::pack("AAPL"), value));
+  CHECK(index.insert(TickerIndex::pack("AAPL"), 0));
+  CHECK(index.insert(TickerIndex::pack("MSFT"), 1));
+  CHECK_FALSE(index.insert(TickerIndex::pack("AAPL"), 2));
+  CHECK_FALSE(index.insert(0, 3));
+  CHECK(index.size() == 2);
+  REQUIRE(index.find(TickerIndex::pack("MSFT"), value));
+  CHECK(value == 1);
+}
+
+/***/
+TEST_CASE("ticker_index_freeze") {
+  for (const std::size_t num_keys : {0, 1, 2, 3, 100, 20000}) {
+    TickerIndex index;
+    for (std::size_t i = 0; i < num_keys; ++i) {
+      REQUIRE(index.insert(TickerIndex::pack(make_ticker(i)),
+                           static_cast<TickerIndex::value_t>(i)));
+    }
+    REQUIRE(index.freeze());
+    CHECK(index.is_frozen());
+    CHECK(index.size() == num_keys);
+    CHECK(index.freeze());
+
+    bool all_found = true;
+    TickerIndex::value_t value{0};
+    for (std::size_t i = 0; i < num_keys; ++i) {
+      all_found = all_found &&
+                  index.find(TickerIndex::pack(make_ticker(i)), value) &&
+                  value == i;
+    }
+    CHECK(all_found);
+    bool none_found = true;
+    for (std::size_t i = num_keys; i < num_keys + 1000; ++i) {
+      none_found = none_found &&
+                   !index.find(TickerIndex::pack(make_ticker(i)), value);
+    }
+    CHECK(none_found);
+    CHECK_FALSE(index.find(0, value));
+    CHECK_FALSE(index.insert(TickerIndex::pack("ZZZZZZZZ"), 0));
+  }
+}
+
+TEST_SUITE_END();
\ No newline at end of file